@@ -8,21 +8,30 @@
 # include <fcntl.h>
 # include <limits.h>
 # include <math.h>
+# include <pthread.h>
+# include <stdatomic.h>
 # include <stdbool.h>
+# include <stdint.h>
 # include <stdio.h>
 # include <stdlib.h>
 # include <string.h>
+# include <sys/mman.h>
+# include <time.h>
 # include <unistd.h>
+# ifdef __SSE2__
+#  include <emmintrin.h>
+# endif
 
 // OWN .H
 # include "../libft/include/libft.h"
 # include "../mlx/mlx.h"
-# include "structs.h"
 # include "vals.h"
+# include "structs.h"
 
 // SRC
 // init_vars.c
 void	init_vars(t_vars **vars);
+void	init_window(t_vars *vars);
 // check_args_01.c
 int		check_args(int argc, char *argv[], t_vars *vars);
 // check_args_02.c
@@ -32,6 +41,16 @@ int		check_map_exists(char *path, t_vars *vars);
 void	parse_file(t_vars *vars);
 // check_args_04.c
 void	assign_colors(t_vars *vars);
+// check_args_05.c
+int		set_value_04(t_vars *vars, char *value);
+int		check_options(int argc, char *argv[], t_vars *vars);
+// check_args_06.c
+int		set_value_05(t_vars *vars, char *value);
+// backend_headless.c
+const t_backend	*backend_headless(void);
+void	snapshot_write(t_vars *vars);
+// backend_mlx.c
+const t_backend	*backend_mlx(void);
 // check_map_01.c
 int		check_map_valid(t_vars *vars);
 // check_map_02.c
@@ -42,6 +61,13 @@ int		check_flood(t_vars *vars);
 int		load_textures(t_vars *vars);
 // load_textures_bonus.c
 int		load_textures_bonus(t_vars *vars);
+// load_textures_utils.c
+size_t	texture_layout(t_texture *tex, int width, int height);
+void	texture_to_columns(t_img *image, t_mip *mip);
+void	texture_build_mips(t_texture *tex, int masked);
+// texture_arena.c
+void	texture_arena_build(t_game *game, int count);
+void	texture_arena_free(t_game *game);
 // key_mapping.c
 int		close_window(t_vars *vars);
 void	update_movement(t_game *game);
@@ -54,34 +80,202 @@ void	move_backward(t_game *game);
 void	move_right(t_game *game);
 void	move_left(t_game *game);
 // ray_casting_00.c
+void	render_scene(t_game *game);
 int		render(t_vars *vars);
+// bench_report.c
+int		compare_ms(const void *a, const void *b);
+void	bench_begin(t_bench *bench);
+void	bench_report(t_bench *bench, char *map, t_frame *out);
+void	bench_end(t_bench *bench);
+// bench_present.c
+int		bench_present(t_bench *bench);
+// door_anim.c
+void	door_anim_set(t_game *game, unsigned long long ns);
+void	door_anim_update(t_game *game);
+// sim.c
+void	camera_get(t_game *game, t_camera *cam);
+void	camera_set(t_game *game, t_camera *cam);
+double	sim_advance(t_game *game);
+void	sim_interpolate(t_game *game, double alpha);
+void	sim_turn(t_game *game, double angle);
+void	sim_pause(t_game *game);
+// perf.c
+void	perf_begin(t_game *game);
+void	perf_mark(t_game *game);
+void	perf_stage(t_game *game, int stage);
+void	perf_end(t_game *game);
+void	perf_toggle(t_game *game);
+void	perf_wake(t_game *game, unsigned long long woke);
+// perf_overlay.c
+void	perf_overlay_draw(t_game *game);
+void	perf_overlay_text(t_game *game);
+// perf_report.c
+void	perf_report(t_game *game);
+// render_api.c
+t_vars	*render_open(char *map_path, int width, int height);
+int		render_frame(t_game *game, t_camera *cam, t_frame *out);
+void	render_close(t_vars *vars);
+// render_background.c
+void	background_build(t_game *game);
+// render_damage.c
+int		damage_collect(t_game *game);
+long	damage_idle_us(t_game *game, int damage);
+int		damage_expose(t_vars *vars);
+// render_dynres.c
+void	dynres_init(t_game *game);
+void	dynres_begin(t_game *game);
+void	dynres_end(t_game *game);
+// render_floor.c
+void	render_floor(t_game *game);
+// render_floor_span.c
+void	scanline_draw(t_game *game, t_scanline *sl, int y);
+// render_sprites.c
+void	render_sprites(t_game *game);
+// render_sprites_draw.c
+void	sprite_tile(void *ctx, int tile);
+// render_sprites_sort.c
+void	sprite_sort(t_sprites *s);
+// sprites.c
+void	sprite_add(t_game *game, double x, double y, int type);
+void	sprites_free(t_game *game);
+// render_scale.c
+void	render_resize(t_game *game, double scale);
+void	render_upscale(t_game *game);
+// render_tables.c
+void	tables_build(t_game *game);
+// render_transpose.c
+void	transpose_columns(t_game *game, int x_start, int x_end);
+// render_debug.c
+void	coverage_poison(t_game *game);
+void	coverage_check(t_game *game);
+// render_threads.c
+void	pool_init(t_pool *pool, int count);
+void	pool_run(t_pool *pool, t_task task, void *ctx, int tiles);
+void	pool_destroy(t_pool *pool);
+// render_threads_utils.c
+int		render_thread_count(void);
+void	pool_split_tiles(t_pool *pool, int tiles);
+void	pool_work(t_pool *pool, int id);
 // ray_casting_init.c
-void	process_ray_casting(t_game *game, t_vars *vars, t_ray_cast *rc);
+void	perform_dda(t_game *game, t_ray_cast *rc);
+void	trace_rays(t_game *game, t_ray_cast *rc, int count);
 void	initialize_step_and_sidedist(t_game *game, t_ray_cast *rc);
 void	initialize_ray_position(t_game *game, t_ray_cast *rc);
 void	calculate_ray_direction(t_game *game, t_ray_cast *rc);
+// ray_casting_skip.c
+void	perform_dda_skip(t_game *game, t_ray_cast *rc);
+// occupancy.c
+void	occupancy_build(t_game *game);
+void	occupancy_free(t_game *game);
+void	map_set(t_game *game, int x, int y, uint8_t value);
+// ray_casting_packet.c
+void	perform_dda_packet(t_game *game, t_ray_cast *rc);
 // ray_casting_core_01.c
-void	render_column(t_game *game, t_vars *vars, t_ray_cast *rc);
+void	render_column(t_game *game, t_ray_cast *rc);
 // ray_casting_core_02.c
-void	draw_ceiling_and_floor(t_ray_cast *rc,
-			t_ray_cast_draw *rcw, t_vars *vars);
-void	draw_wall_column(t_game *game, t_ray_cast *rc, t_ray_cast_draw *rcw,
-			t_img *texture);
+void	draw_ceiling_and_floor(t_game *game, int x);
+void	draw_wall_column(t_ray_cast_draw *rcw, t_mip *mip, int height);
 void	calculate_texture_coordinates(t_game *game, t_ray_cast *rc,
-			t_ray_cast_draw *rcw, t_img *texture);
+			t_ray_cast_draw *rcw, t_mip *mip);
 // ray_casting_utils.c
-void	put_pixel_fog_floor(t_vars *vars, int x, int y, double fogDistance);
-void	put_pixel_fog_ceiling(t_vars *vars, int x, int y, double fogDistance);
-void	put_pixel_fog_walls(t_img *img, int x, t_ray_cast_draw *rcw);
+int		fog_level(t_fog *fog, double distance);
+void	put_span_fog_walls(t_ray_cast_draw *rcw, unsigned int *src,
+			unsigned int pos, unsigned int step);
+// fog.c
+void	fog_build(t_fog *fog, int floor_color, int ceiling_color);
+void	fog_set(t_vars *vars, double distance, int color);
+// xpm.c
+int		xpm_load(char *path, t_img *image);
+// xpm_utils.c
+void	xpm_strip_comments(char *buf);
+char	*xpm_next_string(char *buf, size_t *pos);
+int		xpm_parse_color(char *line, unsigned int *color);
 // mini_map.c
 void	draw_minimap(t_game *game);
 // cleaner.c
 void	clean_exit(t_vars *vars);
 //cleaner_utils.c
 void	free_char_matrix(char **mtx);
-void	free_int_matrix(t_vars *vars, int **mtx);
+void	free_grid(t_game *game);
 void	free_paths(t_vars *vars);
 void	free_colors(t_vars *vars);
 void	free_textures(t_game *game);
 
+// MiniLibX (mlx_rgb.c)
+extern t_col_name	mlx_col_name[];
+
+// INLINE
+/**
+ * @brief Returns the world map cell at (x, y).
+ *
+ * The map is one contiguous byte grid (0 empty, 1 wall, 2 closed door, 3 open door)
+ * surrounded by a one-cell wall border, so any cell next to a valid one, including
+ * (-1, y) and (map_width, y), can be read or written without a bounds check.
+ *
+ * @param game Pointer to the t_game structure holding the grid.
+ * @param x Column of the cell, in [-1, map_width].
+ * @param y Row of the cell, in [-1, map_height].
+ * @return uint8_t* Pointer to the cell.
+ */
+static inline uint8_t	*map_cell(t_game *game, int x, int y)
+{
+	return (game->grid + (ptrdiff_t)y * game->grid_stride + x);
+}
+
+/**
+ * @brief Returns the solid-cell counter of the occupancy block holding cell (x, y).
+ *
+ * Level l groups the grid (border included) into squares of 1 << (OCC_SHIFT * (l + 1))
+ * cells, i.e. 8x8 and 64x64.
+ *
+ * @param game Pointer to the t_game structure holding the occupancy pyramid.
+ * @param level Pyramid level.
+ * @param x Column of the cell, in [-1, map_width].
+ * @param y Row of the cell, in [-1, map_height].
+ * @return uint16_t* Pointer to the number of solid cells in the block.
+ */
+static inline uint16_t	*occ_block(t_game *game, int level, int x, int y)
+{
+	int	shift;
+
+	shift = OCC_SHIFT * (level + 1);
+	return (game->occ.blocks[level] + ((y + 1) >> shift) * game->occ.stride[level]
+		+ ((x + 1) >> shift));
+}
+
+/**
+ * @brief Returns the monotonic clock in nanoseconds, for the stage and frame timers.
+ *
+ * @return unsigned long long The current time in nanoseconds.
+ */
+static inline unsigned long long	stage_clock(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+/**
+ * @brief Adds the time elapsed since start to a benchmark stage.
+ *
+ * Only called when BENCH is set; workers add to the same counters, so the add is atomic.
+ * Returning the current time lets consecutive stages be chained without a second clock read.
+ *
+ * @param game Pointer to the t_game structure holding the stage counters.
+ * @param stage The stage to charge (see t_stage).
+ * @param start Time the stage started, from stage_clock().
+ * @return unsigned long long The current time, the start of the next stage.
+ */
+static inline unsigned long long	stage_add(t_game *game, int stage,
+	unsigned long long start)
+{
+	unsigned long long	now;
+
+	now = stage_clock();
+	atomic_fetch_add_explicit(&game->stages.ns[stage], now - start,
+		memory_order_relaxed);
+	return (now);
+}
+
 #endif
\ No newline at end of file
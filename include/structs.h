@@ -1,6 +1,14 @@
 #ifndef STRUCTS_H
 # define STRUCTS_H
 
+// Nivel de mipmap de una textura, guardado por columnas
+typedef struct s_mip
+{
+	unsigned int	*columns;
+	int				width;
+	int				height;
+}				t_mip;
+
 typedef struct s_img
 {
 	void		*img;
@@ -12,6 +20,32 @@ typedef struct s_img
 	int			endian;
 }				t_img;
 
+// Estado del lector de XPM: fichero, tabla de colores y claves de píxel
+typedef struct s_xpm
+{
+	char			*buf;
+	size_t			pos;
+	int				nc;
+	int				cpp;
+	unsigned int	*colors;
+	char			**keys;
+	int				*direct;
+}				t_xpm;
+
+// Color con nombre X11 de la tabla de MiniLibX (mlx_rgb.c)
+typedef struct s_col_name
+{
+	char		*name;
+	int			color;
+}				t_col_name;
+
+// Textura empaquetada en la arena: cadena de mipmaps por columnas
+typedef struct s_texture
+{
+	t_mip		mips[MAX_MIPS];
+	int			mip_count;
+}				t_texture;
+
 typedef enum e_orientation
 {
 	NORTH = 0,
@@ -21,17 +55,336 @@ typedef enum e_orientation
 	DOOR1 = 4,
 	DOOR2 = 5,
 	DOOR3 = 6,
-	DOOR4 = 7
+	DOOR4 = 7,
+	FLOOR = 8,
+	CEILING = 9,
+	SPRITE1 = 10,
+	SPRITE2 = 11,
+	SPRITE3 = 12,
+	SPRITE4 = 13
 }				t_orientation;
 
+// Etapas del render medidas por el benchmark (BENCH)
+typedef enum e_stage
+{
+	STAGE_SETUP = 0,
+	STAGE_DDA = 1,
+	STAGE_WALLS = 2,
+	STAGE_BACKGROUND = 3,
+	STAGE_TRANSPOSE = 4,
+	STAGE_TILES = 5,
+	STAGE_FLOOR = 6,
+	STAGE_SPRITES = 7,
+	STAGE_UPSCALE = 8,
+	STAGE_COUNT = 9
+}				t_stage;
+
+// Destino de render: píxeles de 32 bits, pitch en píxeles
+typedef struct s_frame
+{
+	unsigned int	*pixels;
+	int				width;
+	int				height;
+	int				pitch;
+}				t_frame;
+
+// Tablas de niebla por nivel de distancia cuantizado
+typedef struct s_fog
+{
+	double			distance;
+	int				color;
+	double			level_scale;
+	unsigned int	scale[FOG_LEVELS];
+	unsigned int	add[FOG_LEVELS];
+	unsigned int	floor[FOG_LEVELS];
+	unsigned int	ceiling[FOG_LEVELS];
+}				t_fog;
+
+// Pirámide de ocupación: celdas sólidas por bloque de 8x8 y 64x64
+typedef struct s_occupancy
+{
+	uint16_t	*blocks[OCC_LEVELS];
+	int			stride[OCC_LEVELS];
+	int			enabled;
+}				t_occupancy;
+
+// Tablas precalculadas para la resolución de render actual
+typedef struct s_tables
+{
+	double		*camera_x;
+	double		*row_dist;
+	int			width;
+	int			height;
+}				t_tables;
+
+// Tramo de pared dibujado en una columna del frame: filas [top, bottom)
+typedef struct s_span
+{
+	int			top;
+	int			bottom;
+}				t_span;
+
+// Fila del suelo o del techo: posición en la celda (0.32) y paso por píxel
+typedef struct s_scanline
+{
+	uint32_t		u;
+	uint32_t		v;
+	uint32_t		du;
+	uint32_t		dv;
+	t_mip			*mip;
+	unsigned int	w;
+	unsigned int	h;
+	unsigned int	fog_scale;
+	unsigned int	fog_add;
+	unsigned int	*row;
+	int				floor;
+}				t_scanline;
+
+// Sprite del mapa: posición en el mundo y tipo (SPRITE1 + type)
+typedef struct s_sprite
+{
+	double		x;
+	double		y;
+	int			type;
+}				t_sprite;
+
+// Sprite proyectado en el frame: columnas [x0, x1) y filas [y0, y1) visibles
+typedef struct s_sprite_view
+{
+	double			depth;
+	int				left;
+	int				top;
+	int				width;
+	int				height;
+	int				x0;
+	int				x1;
+	int				y0;
+	int				y1;
+	t_mip			*mip;
+	unsigned int	fog_scale;
+	unsigned int	fog_add;
+}				t_sprite_view;
+
+// Sprites del mapa y listas de trabajo del frame (claves y orden dobles para el radix)
+typedef struct s_sprites
+{
+	t_sprite		*list;
+	int				count;
+	int				cap;
+	t_sprite_view	*views;
+	uint32_t		*keys;
+	int				*order;
+	int				visible;
+	uint16_t		*cover;
+	size_t			cover_size;
+}				t_sprites;
+
+// Píxeles ya tapados en un tile de sprites: bits por fila (limpias en [lo, hi)), columnas
+// tras la pared y banda [top, bottom) completa alrededor del horizonte
+typedef struct s_sprite_cover
+{
+	uint16_t		*rows;
+	uint16_t		blocked;
+	int				x;
+	int				lo;
+	int				hi;
+	int				top;
+	int				bottom;
+}				t_sprite_cover;
+
+// Nanosegundos acumulados por etapa (solo con BENCH)
+typedef struct s_stages
+{
+	_Atomic(unsigned long long)	ns[STAGE_COUNT];
+}				t_stages;
+
+// Etapas de render() medidas por el overlay de rendimiento
+typedef enum e_perf_stage
+{
+	PERF_MOVE = 0,
+	PERF_SCENE = 1,
+	PERF_MINIMAP = 2,
+	PERF_PRESENT = 3,
+	PERF_STAGES = 4
+}				t_perf_stage;
+
+// Tiempos de un frame: inicio en ns, duración total y por etapa en ms
+typedef struct s_perf_sample
+{
+	unsigned long long	start;
+	float				frame_ms;
+	float				stage_ms[PERF_STAGES];
+}				t_perf_sample;
+
+// Temporizadores de render(): últimos frames en un anillo, histograma de toda la partida
+typedef struct s_perf
+{
+	t_perf_sample			ring[PERF_FRAMES];
+	_Atomic(unsigned long)	head;
+	t_perf_sample			current;
+	unsigned long long		mark;
+	unsigned int			hist[PERF_BUCKETS];
+	unsigned long			count;
+	double					total_ms;
+	double					stage_total[PERF_STAGES];
+	double					max_ms;
+	unsigned long			wakes;
+	double					wake_total_ms;
+	double					wake_max_ms;
+	int						overlay;
+}				t_perf;
+
+// Parámetros y resultados del benchmark (make bench)
+typedef struct s_bench
+{
+	int					frames;
+	int					width;
+	int					height;
+	int					csv;
+	int					present;
+	int					maps;
+	double				*frame_ms;
+	double				stage_ms[STAGE_COUNT];
+	unsigned long long	hash;
+}				t_bench;
+
+// Estado de la última imagen dibujada, para reutilizarla si nada ha cambiado
+typedef struct s_damage
+{
+	double				view[6];
+	int					render_w;
+	int					render_h;
+	int					cell_x;
+	int					cell_y;
+	unsigned long		map_gen;
+	unsigned long		drawn_gen;
+	unsigned long long	door_step;
+	atomic_int			doors_seen;
+	int					pending;
+}				t_damage;
+
+// Control de resolución dinámica: tiempos de frame en ms y escala actual
+typedef struct s_dynres
+{
+	double			budget_ms;
+	double			max_scale;
+	double			frame_ms[DYNRES_WINDOW];
+	double			last_ms;
+	double			avg_ms;
+	int				count;
+	int				cooldown;
+	struct timespec	start;
+}				t_dynres;
+
+typedef void	(*t_task)(void *ctx, int tile);
+
+struct		s_game;
+
+// Backend de presentación: abre la salida, elige el buffer, muestra los frames, espera y la cierra
+typedef struct s_backend
+{
+	int			(*open)(struct s_game *game);
+	void		(*acquire)(struct s_game *game);
+	void		(*present)(struct s_game *game, int damage);
+	void		(*idle)(struct s_game *game, long usec);
+	void		(*close)(struct s_game *game);
+}				t_backend;
+
+// Cámara de render_frame(): posición, dirección y plano de la cámara
+typedef struct s_camera
+{
+	double		x;
+	double		y;
+	double		dir_x;
+	double		dir_y;
+	double		plane_x;
+	double		plane_y;
+}				t_camera;
+
+// Simulación a paso fijo: reloj, tiempo pendiente y los dos últimos estados
+typedef struct s_sim
+{
+	unsigned long long	last;
+	unsigned long long	acc;
+	t_camera			prev;
+	t_camera			curr;
+}				t_sim;
+
+// Animación de las puertas: inicio, paso actual y textura de cada fase
+typedef struct s_anim
+{
+	unsigned long long	start;
+	unsigned long long	step;
+	int					door_tex[DOOR_FRAMES];
+}				t_anim;
+
+// Rango de tiles de un worker: head en los 32 bits bajos, tail en los altos
+typedef struct s_tile_queue
+{
+	_Atomic(unsigned long long)	range;
+	char						pad[64 - sizeof(unsigned long long)];
+}				t_tile_queue;
+
+typedef struct s_worker
+{
+	struct s_pool	*pool;
+	int				id;
+}				t_worker;
+
+typedef struct s_pool
+{
+	pthread_t		*threads;
+	t_worker		*workers;
+	t_tile_queue	*queues;
+	int				count;
+	t_task			task;
+	void			*ctx;
+	pthread_mutex_t	lock;
+	pthread_cond_t	start;
+	pthread_cond_t	done;
+	unsigned long	generation;
+	int				pending;
+	int				quit;
+}				t_pool;
+
 // Estructura principal del juego
 typedef struct s_game
 {
+	const t_backend	*backend;
 	void		*mlx;
 	void		*win;
-	t_img		img;
-	t_img		textures[8];
-	int			**world_map;
+	t_img		img[PRESENT_BUFFERS];
+	int			front;
+	char		*present_mode;
+	t_frame		output;
+	unsigned int	*headless;
+	int			width;
+	int			height;
+	double		render_scale;
+	int			render_w;
+	int			render_h;
+	t_frame		target;
+	t_dynres	dynres;
+	unsigned int	*colbuf;
+	unsigned int	*lowres;
+	int			*upscale_x;
+	t_tables	tables;
+	t_span		*spans;
+	t_span		covered;
+	double		*zbuf;
+	double		*zbuf_tile;
+	t_sprites	sprites;
+	unsigned int	*background;
+	t_img		textures[TEXTURE_SLOTS];
+	t_texture	tex[TEXTURE_SLOTS];
+	unsigned int	*tex_arena;
+	size_t		tex_arena_size;
+	uint8_t		*grid;
+	int			grid_stride;
+	t_occupancy	occ;
+	t_damage	damage;
+	t_stages	stages;
+	t_perf		perf;
 	double		player_x;
 	double		player_y;
 	double		dir_x;
@@ -46,6 +399,10 @@ typedef struct s_game
 	int			key_left;
 	int			key_right;
 	int			door_cooldown;
+	t_sim		sim;
+	t_anim		anim;
+	t_pool		pool;
+	t_fog		fog;
 	int			map_width;
 	int			map_height;
 
@@ -78,6 +435,9 @@ typedef struct s_paths
 	char		*so;
 	char		*we;
 	char		*ea;
+	char		*ft;
+	char		*ct;
+	char		*sprite[SPRITE_TYPES];
 }				t_paths;
 
 typedef struct s_vars
@@ -90,6 +450,7 @@ typedef struct s_vars
 	int			bytes_read;
 
 	char		*map_path;
+	char		*snapshot;
 	char		*buffer;
 	char		**file;
 	char		**map;
@@ -124,9 +485,10 @@ typedef struct s_ray_cast_draw
 	int			draw_end;
 	int			tex_num;
 	int			tex_x;
-	int			d;
-	int			tex_y;
 	int			color;
+	unsigned int	fog_scale;
+	unsigned int	fog_add;
+	unsigned int	*column;
 }				t_ray_cast_draw;
 
 typedef struct s_minimap
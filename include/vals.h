@@ -5,16 +5,96 @@
 #  define BONUS 0
 # endif
 
+# ifndef DEBUG
+#  define DEBUG 0
+# endif
+
+# ifndef BENCH
+#  define BENCH 0
+# endif
+
 # define BUFF_SIZE 999999
 
 # define OK 0
 # define ERROR 1
 
-# define WIDTH 1280
-# define HEIGHT 960
-# define MOVE_SPEED 0.15
-# define ROT_SPEED 0.15
+# define DEFAULT_WIDTH 1280
+# define DEFAULT_HEIGHT 960
+# define MIN_RESOLUTION 64
+# define MAX_RESOLUTION 8192
+# define DEFAULT_RENDER_SCALE 1.0
+# define MIN_RENDER_SCALE 0.25
+# define UPSCALE_BAND 16
+# define FLOOR_BAND 8
+# define DYNRES_WINDOW 16
+# define DYNRES_COOLDOWN 30
+# define DYNRES_LOW 0.75
+# define DYNRES_STEP 0.05
+# define SIM_HZ 120
+# define SIM_MAX_TICKS 8
+# define MOVE_SPEED 4.5
+# define ROT_SPEED 3.0
+# define DOOR_COOLDOWN 0.25
+# define DOOR_FRAMES 4
+# define DOOR_FPS 8
+# define MIN_WALL_DIST 0.0001
+# define FOV_PLANE 0.66
+
+# define FOG_LEVELS 256
+# define MAX_MIPS 14
+# define TEXTURE_SLOTS 14
+# define TEXEL_MASKED 0xFF000000
+# ifndef TEXTURE_HUGE_PAGES
+#  define TEXTURE_HUGE_PAGES 0
+# endif
+# define HUGE_PAGE_SIZE 2097152
+# define FOG_DISTANCE 10.0
+# define FOG_COLOR 0x000000
+
+# define COVERAGE_POISON 0xFFFF00FF
+
+# ifndef THREADS
+#  define THREADS 0
+# endif
+# define MAX_THREADS 64
+# define RENDER_TILE 16
+# ifndef RAY_PACKET
+#  define RAY_PACKET 4
+# endif
+# if RAY_PACKET < 2 || RAY_PACKET % 2 || RAY_PACKET > RENDER_TILE
+#  error "RAY_PACKET must be an even number from 2 to RENDER_TILE"
+# endif
+
+# define OCC_LEVELS 2
+# define OCC_SHIFT 3
+# define OCC_MIN_MAP 64
+
+# define DAMAGE_SCENE 1
+# define DAMAGE_PRESENT 2
+# define DAMAGE_MINIMAP 4
+# ifndef PRESENT_BUFFERS
+#  define PRESENT_BUFFERS 2
+# endif
+
+# define BENCH_FRAMES 600
+# define BENCH_WARMUP 30
+# define BENCH_TURN 0.02
+# define BENCH_BOUNCE 1.0
+
+# define PERF_FRAMES 128
+# define PERF_BUCKET_US 50
+# define PERF_BUCKETS 2000
+# define PERF_GRAPH_H 64
+# define PERF_GRAPH_MS 33.3
+# define PERF_BAR_W 2
+# define PERF_MARGIN 10
+# define PERF_LINE_H 14
+# define PERF_LINES 3
 
+# define SPRITE_TYPES 4
+# define SPRITE_NEAR 0.05
+# define SPRITE_COVER_FULL (0xFFFFu >> (16 - RENDER_TILE))
+# define RADIX_BITS 8
 # define TILE_SIZE 10
 # define MAP_OFFSET 10
 # define MINIMAP_RADIUS 5
@@ -75,6 +75,23 @@ char	*mlx_get_data_addr(void *img_ptr, int *bits_per_pixel,
 int	mlx_put_image_to_window(void *mlx_ptr, void *win_ptr, void *img_ptr,
 				int x, int y);
 int	mlx_get_color_value(void *mlx_ptr, int color);
+char	*mlx_present_mode(void *mlx_ptr, void *img_ptr);
+/*
+**  images are put straight to the window : with MIT-SHM when the server
+**  is local and supports it, otherwise with a plain XPutImage.
+**  The MLX_PRESENT environment variable forces a path : "ximage" turns
+**  shared memory off, "copy" goes through a pixmap like older MiniLibX,
+**  anything else ("direct") keeps the default.
+**  mlx_present_mode names the path used for an image.
+*/
+int	mlx_image_busy(void *mlx_ptr, void *img_ptr);
+int	mlx_image_wait(void *mlx_ptr, void *img_ptr);
+/*
+**  shared memory images stay busy until the X server has read them:
+**  mlx_image_busy returns non-zero while a put is still pending,
+**  mlx_image_wait blocks until the image can be written again.
+**  Other images are never busy.
+*/
 
 
 /*
@@ -88,6 +105,17 @@ int	mlx_expose_hook (void *win_ptr, int (*funct_ptr)(), void *param);
 int	mlx_loop_hook (void *mlx_ptr, int (*funct_ptr)(), void *param);
 int	mlx_loop (void *mlx_ptr);
 int mlx_loop_end (void *mlx_ptr);
+int	mlx_loop_events (void *mlx_ptr);
+int	mlx_loop_wakeup (void *mlx_ptr, long usec);
+unsigned long long	mlx_loop_woke (void *mlx_ptr);
+/*
+**  mlx_loop_events is mlx_loop without busy waiting : between calls of
+**  the loop hook it sleeps until an event arrives or the delay the hook
+**  gave to mlx_loop_wakeup has passed (usec < 0 : events only).
+**  A hook that does not call mlx_loop_wakeup runs again at once.
+**  mlx_loop_woke returns when the loop last woke up (CLOCK_MONOTONIC ns),
+**  once, or 0 if it has not slept since.
+*/
 
 /*
 **  hook funct are called as follow :
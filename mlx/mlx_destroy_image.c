@@ -14,9 +14,17 @@
 
 int	mlx_destroy_image(t_xvar *xvar, t_img *img)
 {
+  t_img	**link;
+
   if (img->type == MLX_TYPE_SHM_PIXMAP ||
       img->type == MLX_TYPE_SHM)
     {
+      mlx_image_wait(xvar, img);
+      link = &xvar->shm_list;
+      while (*link && *link != img)
+	link = &(*link)->next;
+      if (*link)
+	*link = img->next;
       XShmDetach(xvar->display, &(img->shm));
       shmdt(img->shm.shmaddr);
       /* shmctl IPC_RMID already done */
@@ -21,5 +21,7 @@ int	mlx_flush_event(t_xvar *xvar)
   while (XPending(xvar->display))
   {
      XNextEvent(xvar->display,&ev);
+     if (ev.type == xvar->shm_completion)
+       mlx_int_shm_done(xvar, &ev);
   }
 }
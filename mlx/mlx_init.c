@@ -45,6 +45,9 @@ void	*mlx_init()
 				 xvar->visual,AllocNone);
 	mlx_int_rgb_conversion(xvar);
 	xvar->end_loop = 0;
+	xvar->loop_timer = -1;
+	xvar->loop_wait = 0;
+	bzero(&xvar->loop_woke, sizeof(xvar->loop_woke));
 	return (xvar);
 }
 
@@ -60,6 +63,7 @@ int		mlx_int_deal_shm(t_xvar *xvar)
 	int		use_pshm;
 	int		bidon;
 	char	*dpy;
+	char	*present;
 	char	buff[33];
 
 	xvar->use_xshm = XShmQueryVersion(xvar->display,&bidon,&bidon,&(use_pshm));
@@ -67,6 +71,7 @@ int		mlx_int_deal_shm(t_xvar *xvar)
 		xvar->pshm_format = XShmPixmapFormat(xvar->display);
 	else
 		xvar->pshm_format = -1;
+	xvar->shm_list = 0;
 	gethostname(buff,32);
 	dpy = getenv(ENV_DISPLAY);
 	if (dpy && strlen(dpy) && *dpy!=':' && strncmp(dpy,buff,strlen(buff)) &&
@@ -75,6 +80,15 @@ int		mlx_int_deal_shm(t_xvar *xvar)
 		xvar->pshm_format = -1;
 		xvar->use_xshm = 0;
 	}
+	present = getenv(ENV_PRESENT);
+	if (present && !strcmp(present, "ximage"))
+		xvar->use_xshm = 0;
+	xvar->present_copy = present && !strcmp(present, "copy");
+	if (!xvar->use_xshm || xvar->present_copy)
+		xvar->pshm_format = -1;
+	xvar->shm_completion = -1;
+	if (xvar->use_xshm)
+		xvar->shm_completion = XShmGetEventBase(xvar->display) + ShmCompletion;
 }
 
 /*
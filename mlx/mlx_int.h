@@ -28,6 +28,11 @@
 # include <X11/Xutil.h>
 # include <sys/ipc.h>
 # include <sys/shm.h>
+# include <sys/timerfd.h>
+# include <poll.h>
+# include <errno.h>
+# include <time.h>
+# include <stdint.h>
 # include <X11/extensions/XShm.h>
 # include <X11/XKBlib.h>
 /* #include	<X11/xpm.h> */
@@ -42,6 +47,7 @@
 
 # define ENV_DISPLAY "DISPLAY"
 # define LOCALHOST "localhost"
+# define ENV_PRESENT "MLX_PRESENT"
 # define ERR_NO_TRUECOLOR "MinilibX Error : No TrueColor Visual available.\n"
 # define WARN_SHM_ATTACH "MinilibX Warning : X server can't attach shared memory.\n"
 
@@ -95,6 +101,8 @@ typedef struct	s_img
 	int				format;
 	char			*data;
 	XShmSegmentInfo	shm;
+	int				busy;
+	struct s_img	*next;
 }				t_img;
 
 typedef struct	s_xvar
@@ -111,11 +119,17 @@ typedef struct	s_xvar
 	void		*loop_param;
 	int			use_xshm;
 	int			pshm_format;
+	int			shm_completion;
+	int			present_copy;
+	t_img		*shm_list;
 	int			do_flush;
 	int			decrgb[6];
 	Atom		wm_delete_window;
 	Atom		wm_protocols;
 	int 		end_loop;
+	int			loop_timer;
+	long		loop_wait;
+	struct timespec	loop_woke;
 }				t_xvar;
 
 
@@ -131,6 +145,9 @@ void			*mlx_int_new_xshm_image();
 char			**mlx_int_str_to_wordtab();
 void			*mlx_new_image();
 int				shm_att_pb();
+void			mlx_int_shm_done(t_xvar *xvar, XEvent *ev);
+int				mlx_image_busy();
+int				mlx_image_wait();
 int				mlx_int_get_visual(t_xvar *xvar);
 int				mlx_int_set_win_event_mask(t_xvar *xvar);
 int				mlx_int_str_str_cote(char *str,char *find,int len);
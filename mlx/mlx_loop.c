@@ -34,10 +34,29 @@ int			mlx_loop_end(t_xvar *xvar)
 	return (1);
 }
 
+/*
+** Hands an event to the hook of its window.
+*/
+
+static void	dispatch_event(t_xvar *xvar, XEvent *ev)
+{
+	t_win_list	*win;
+
+	if (ev->type == xvar->shm_completion)
+		mlx_int_shm_done(xvar, ev);
+	win = xvar->win_list;
+	while (win && (win->window!=ev->xany.window))
+		win = win->next;
+
+	if (win && ev->type == ClientMessage && ev->xclient.message_type == xvar->wm_protocols && ev->xclient.data.l[0] == xvar->wm_delete_window && win->hooks[DestroyNotify].hook)
+		win->hooks[DestroyNotify].hook(win->hooks[DestroyNotify].param);
+	if (win && ev->type < MLX_MAX_EVENT && win->hooks[ev->type].hook)
+		mlx_int_param_event[ev->type](xvar, ev, win);
+}
+
 int			mlx_loop(t_xvar *xvar)
 {
 	XEvent		ev;
-	t_win_list	*win;
 
 	mlx_int_set_win_event_mask(xvar);
 	xvar->do_flush = 0;
@@ -46,18 +65,102 @@ int			mlx_loop(t_xvar *xvar)
 		while (!xvar->end_loop && (!xvar->loop_hook || XPending(xvar->display)))
 		{
 			XNextEvent(xvar->display,&ev);
-			win = xvar->win_list;
-			while (win && (win->window!=ev.xany.window))
-				win = win->next;
-
-			if (win && ev.type == ClientMessage && ev.xclient.message_type == xvar->wm_protocols && ev.xclient.data.l[0] == xvar->wm_delete_window && win->hooks[DestroyNotify].hook)
-				win->hooks[DestroyNotify].hook(win->hooks[DestroyNotify].param);
-			if (win && ev.type < MLX_MAX_EVENT && win->hooks[ev.type].hook)
-				mlx_int_param_event[ev.type](xvar, &ev, win);
+			dispatch_event(xvar, &ev);
 		}
-		XSync(xvar->display, False);
+		XFlush(xvar->display);
 		if (xvar->loop_hook)
 			xvar->loop_hook(xvar->loop_param);
 	}
 	return (0);
 }
+
+/*
+** Asks mlx_loop_events() to run the loop hook again after usec
+** microseconds at the latest, or only when an event comes if usec < 0.
+** Events always run it at once. It only lasts until the next call of the
+** hook, so a hook that wants to wait calls it every time.
+*/
+
+int			mlx_loop_wakeup(t_xvar *xvar, long usec)
+{
+	struct itimerspec	when;
+
+	xvar->loop_wait = usec;
+	if (xvar->loop_timer < 0 || !usec)
+		return (0);
+	bzero(&when, sizeof(when));
+	if (usec > 0)
+	{
+		when.it_value.tv_sec = usec / 1000000;
+		when.it_value.tv_nsec = usec % 1000000 * 1000;
+	}
+	timerfd_settime(xvar->loop_timer, 0, &when, 0);
+	return (0);
+}
+
+/*
+** Returns when mlx_loop_events() last woke from a sleep, in nanoseconds
+** of CLOCK_MONOTONIC, and forgets it : 0 if it has not slept since the
+** last call. The time to present a frame after waking is now - that.
+*/
+
+unsigned long long	mlx_loop_woke(t_xvar *xvar)
+{
+	unsigned long long	woke;
+
+	woke = (unsigned long long)xvar->loop_woke.tv_sec * 1000000000ULL
+		+ xvar->loop_woke.tv_nsec;
+	bzero(&xvar->loop_woke, sizeof(xvar->loop_woke));
+	return (woke);
+}
+
+/*
+** Like mlx_loop(), but sleeps between calls of the loop hook when the hook
+** asked for it with mlx_loop_wakeup() : it blocks in poll() on the X
+** connection and a timerfd until an event arrives or the timer expires.
+** Without a loop hook it waits for events only. Falls back to mlx_loop()
+** when no timerfd can be created, or when reading it fails for any other
+** reason than EAGAIN : the timerfd is non-blocking and reads nothing when
+** it has not expired since the last read, which is the usual case.
+*/
+
+int			mlx_loop_events(t_xvar *xvar)
+{
+	XEvent			ev;
+	struct pollfd	fds[2];
+	uint64_t		expired;
+
+	xvar->loop_timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (xvar->loop_timer < 0)
+		return (mlx_loop(xvar));
+	mlx_int_set_win_event_mask(xvar);
+	xvar->do_flush = 0;
+	fds[0].fd = ConnectionNumber(xvar->display);
+	fds[1].fd = xvar->loop_timer;
+	fds[0].events = POLLIN;
+	fds[1].events = POLLIN;
+	xvar->loop_wait = 0;
+	while (win_count(xvar) && !xvar->end_loop)
+	{
+		if ((xvar->loop_wait || !xvar->loop_hook) && !XPending(xvar->display)
+			&& poll(fds, 2, -1) > 0)
+			clock_gettime(CLOCK_MONOTONIC, &xvar->loop_woke);
+		while (!xvar->end_loop && XPending(xvar->display))
+		{
+			XNextEvent(xvar->display,&ev);
+			dispatch_event(xvar, &ev);
+		}
+		if (read(xvar->loop_timer, &expired, sizeof(expired)) < 0
+			&& errno != EAGAIN && errno != EINTR)
+			break ;
+		xvar->loop_wait = 0;
+		if (xvar->loop_hook && !xvar->end_loop)
+			xvar->loop_hook(xvar->loop_param);
+		XFlush(xvar->display);
+	}
+	close(xvar->loop_timer);
+	xvar->loop_timer = -1;
+	if (win_count(xvar) && !xvar->end_loop)
+		return (mlx_loop(xvar));
+	return (0);
+}
@@ -97,6 +97,8 @@ void	*mlx_int_new_xshm_image(t_xvar *xvar,int width,int height,int format)
 			       width,height,xvar->depth);
       img->type = MLX_TYPE_SHM;
     }
+  img->next = xvar->shm_list;
+  xvar->shm_list = img;
   if (xvar->do_flush)
     XFlush(xvar->display);
   return (img);
@@ -125,6 +127,8 @@ void	*mlx_int_new_image(t_xvar *xvar,int width, int height,int format)
       return ((void *)0);
     }
   img->gc = 0;
+  img->busy = 0;
+  img->next = 0;
   img->size_line = img->image->bytes_per_line;
   img->bpp = img->image->bits_per_pixel;
   img->width = width;
@@ -13,6 +13,29 @@
 #include	"mlx_int.h"
 
 
+/*
+** Old path, kept for MLX_PRESENT=copy : the image is first put into its
+** pixmap, then the pixmap is copied to the window, so the server copies
+** every pixel twice.
+*/
+
+static void	mlx_int_put_copy(t_xvar *xvar,t_win_list *win,t_img *img,
+				 GC gc,int x,int y)
+{
+  if (img->type==MLX_TYPE_SHM || img->type==MLX_TYPE_SHM_PIXMAP)
+    {
+      XShmPutImage(xvar->display,img->pix, win->gc, img->image,0,0,0,0,
+		   img->width,img->height,True);
+      img->busy++;
+    }
+  if (img->type==MLX_TYPE_XIMAGE)
+    XPutImage(xvar->display,img->pix, win->gc, img->image,0,0,0,0,
+	      img->width,img->height);
+  XCopyArea(xvar->display,img->pix,win->window, gc,
+	    0,0,img->width,img->height,x,y);
+}
+
+
 int	mlx_put_image_to_window(t_xvar *xvar,t_win_list *win,t_img *img,
 				int x,int y)
 {
@@ -24,14 +47,33 @@ int	mlx_put_image_to_window(t_xvar *xvar,t_win_list *win,t_img *img,
       gc = img->gc;
       XSetClipOrigin(xvar->display, gc, x, y);
     }
-  if (img->type==MLX_TYPE_SHM)
-    XShmPutImage(xvar->display,img->pix, win->gc, img->image,0,0,0,0,
-		 img->width,img->height,False);
-  if (img->type==MLX_TYPE_XIMAGE)
-    XPutImage(xvar->display,img->pix, win->gc, img->image,0,0,0,0,
+  if (xvar->present_copy)
+    mlx_int_put_copy(xvar, win, img, gc, x, y);
+  else if (img->type==MLX_TYPE_SHM || img->type==MLX_TYPE_SHM_PIXMAP)
+    {
+      XShmPutImage(xvar->display,win->window, gc, img->image,0,0,x,y,
+		   img->width,img->height,True);
+      img->busy++;
+    }
+  else
+    XPutImage(xvar->display,win->window, gc, img->image,0,0,x,y,
 	      img->width,img->height);
-  XCopyArea(xvar->display,img->pix,win->window, gc,
-	    0,0,img->width,img->height,x,y);
   if (xvar->do_flush)
     XFlush(xvar->display);
 }
+
+
+/*
+** Names the path mlx_put_image_to_window() takes for the image :
+** "shm" and "ximage" write it straight to the window, "shm+copy" and
+** "ximage+copy" go through its pixmap (MLX_PRESENT=copy).
+** Shared memory is not used for remote displays, when the server lacks
+** MIT-SHM or cannot attach the segment, or with MLX_PRESENT=ximage.
+*/
+
+char	*mlx_present_mode(t_xvar *xvar,t_img *img)
+{
+  if (img->type==MLX_TYPE_XIMAGE)
+    return (xvar->present_copy ? "ximage+copy" : "ximage");
+  return (xvar->present_copy ? "shm+copy" : "shm");
+}
@@ -0,0 +1,75 @@
+/*
+** mlx_shm_completion.c for MiniLibX
+**
+** Tracks which MIT-SHM images the X server may still be reading.
+** mlx_put_image_to_window() asks for a ShmCompletion event with every
+** XShmPutImage() and counts the image as busy until the event comes back,
+** so a program can render into another image meanwhile and only wait
+** when it wants to write into one that is still on its way to the screen.
+*/
+
+
+#include	"mlx_int.h"
+
+
+/*
+** Marks the image the completion event is about as read.
+** Events for images destroyed in the meantime are ignored.
+*/
+
+void	mlx_int_shm_done(t_xvar *xvar, XEvent *ev)
+{
+  XShmCompletionEvent	*done;
+  t_img			*img;
+
+  done = (XShmCompletionEvent *)ev;
+  img = xvar->shm_list;
+  while (img && img->shm.shmseg != done->shmseg)
+    img = img->next;
+  if (img && img->busy > 0)
+    img->busy--;
+}
+
+
+static Bool	is_shm_done(Display *display, XEvent *ev, XPointer arg)
+{
+  return (ev->type == ((t_xvar *)arg)->shm_completion);
+}
+
+
+/*
+** Returns the number of puts of the image the server has not finished,
+** after taking the completion events already received off the queue.
+** Other events stay queued for mlx_loop().
+*/
+
+int	mlx_image_busy(t_xvar *xvar, t_img *img)
+{
+  XEvent	ev;
+
+  if (!img->busy)
+    return (0);
+  while (XCheckIfEvent(xvar->display, &ev, is_shm_done, (XPointer)xvar))
+    mlx_int_shm_done(xvar, &ev);
+  return (img->busy);
+}
+
+
+/*
+** Blocks until the server has read the image, so it can be written.
+** The server sends ShmCompletion while it handles the put, so once
+** XSync() has its reply every completion still owed is in the queue.
+** A put that failed with an X error sends none : whatever is left
+** busy after that never will be read, and is cleared instead of
+** waiting for it forever.
+*/
+
+int	mlx_image_wait(t_xvar *xvar, t_img *img)
+{
+  if (!mlx_image_busy(xvar, img))
+    return (0);
+  XSync(xvar->display, False);
+  mlx_image_busy(xvar, img);
+  img->busy = 0;
+  return (0);
+}
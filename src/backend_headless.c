@@ -0,0 +1,125 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Allocates the memory frame a headless game renders into.
+ *
+ * Nothing is opened: no X display is needed, so this works on machines without an X server
+ * and with DISPLAY unset. Callers of render_frame() hand in their own frame instead.
+ *
+ * @param game Pointer to the t_game structure; width and height must be set.
+ * @return int Returns OK on success, or ERROR if the allocation fails.
+ */
+static int headless_open(t_game *game)
+{
+	size_t	size;
+
+	size = (((size_t)game->width * game->height * sizeof(unsigned int) + 63) / 64) * 64;
+	game->headless = aligned_alloc(64, size);
+	if (!game->headless)
+		return (ERROR);
+	game->output = (t_frame){game->headless, game->width, game->height, game->width};
+	return (OK);
+}
+
+/**
+ * @brief Does nothing: a headless game always renders into the same memory frame.
+ *
+ * @param game Pointer to the t_game structure.
+ */
+static void headless_acquire(t_game *game)
+{
+	(void)game;
+}
+
+/**
+ * @brief Does nothing: a headless frame stays in memory until it is read.
+ *
+ * @param game Pointer to the t_game structure.
+ * @param damage The damage flags of the frame.
+ */
+static void headless_present(t_game *game, int damage)
+{
+	(void)game;
+	(void)damage;
+}
+
+/**
+ * @brief Does nothing: a headless game has no event loop to put to sleep.
+ *
+ * @param game Pointer to the t_game structure.
+ * @param usec Microseconds until the next frame is due (see damage_idle_us()).
+ */
+static void headless_idle(t_game *game, long usec)
+{
+	(void)game;
+	(void)usec;
+}
+
+/**
+ * @brief Frees the memory frame allocated by headless_open().
+ *
+ * @param game Pointer to the t_game structure.
+ */
+static void headless_close(t_game *game)
+{
+	free(game->headless);
+	game->headless = NULL;
+}
+
+/**
+ * @brief Returns the headless backend, which renders into memory without any display.
+ *
+ * @return const t_backend* Pointer to the backend.
+ */
+const t_backend *backend_headless(void)
+{
+	static const t_backend	backend = {headless_open, headless_acquire,
+		headless_present, headless_idle, headless_close};
+
+	return (&backend);
+}
+
+/**
+ * @brief Renders one frame and writes it to vars->snapshot as a binary PPM image.
+ *
+ * This is what the "-o <file>" option runs instead of opening a window: the first frame is
+ * rendered from the start position like in the game and its pixels are stored as 8-bit RGB.
+ * If the file cannot be written, it prints an error and exits.
+ *
+ * @param vars Pointer to the t_vars structure; the game must use the headless backend.
+ */
+void snapshot_write(t_vars *vars)
+{
+	t_frame			*out;
+	unsigned char	*rgb;
+	int				fd;
+	int				y;
+	int				x;
+
+	render(vars);
+	out = &vars->game->output;
+	fd = open(vars->snapshot, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	rgb = malloc((size_t)out->width * 3);
+	if (fd < 0 || !rgb)
+		return (perror(vars->snapshot), exit(ERROR));
+	ft_putstr_fd("P6\n", fd);
+	ft_putnbr_fd(out->width, fd);
+	ft_putchar_fd(' ', fd);
+	ft_putnbr_fd(out->height, fd);
+	ft_putstr_fd("\n255\n", fd);
+	y = -1;
+	while (++y < out->height)
+	{
+		x = -1;
+		while (++x < out->width)
+		{
+			rgb[3 * x] = out->pixels[(size_t)y * out->pitch + x] >> 16;
+			rgb[3 * x + 1] = out->pixels[(size_t)y * out->pitch + x] >> 8;
+			rgb[3 * x + 2] = out->pixels[(size_t)y * out->pitch + x];
+		}
+		if (write(fd, rgb, (size_t)out->width * 3) != (ssize_t)out->width * 3)
+			return (perror(vars->snapshot), exit(ERROR));
+	}
+	free(rgb);
+	close(fd);
+}
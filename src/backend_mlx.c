@@ -0,0 +1,155 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Describes an MLX image as a frame.
+ *
+ * @param img Pointer to the image.
+ * @param game Pointer to the t_game structure holding the frame size.
+ * @return t_frame The frame over the image's pixels.
+ */
+static t_frame mlx_frame(t_img *img, t_game *game)
+{
+	return ((t_frame){(unsigned int *)img->addr, game->width, game->height,
+		img->line_length / sizeof(unsigned int)});
+}
+
+/**
+ * @brief Opens the X display, the window and the images the frames are rendered into.
+ *
+ * Depending on the BONUS flag, it creates either a standard window ("Cub3d") or a bonus
+ * version window ("Cub3d_bonus"). PRESENT_BUFFERS images are created, shared with the X
+ * server through MIT-SHM when it supports it, so a frame can be rendered into one while the
+ * server still reads another. MLX puts them straight to the window, and the path it takes is
+ * kept in game->present_mode for the performance overlay and the exit report. The first one
+ * becomes the output frame, so at render scale 1 the scene is raycast straight into the pixels
+ * MLX puts to the window.
+ *
+ * @param game Pointer to the t_game structure; width and height must be set.
+ * @return int Returns OK on success, or ERROR if MLX fails (e.g. no X display).
+ */
+static int mlx_open(t_game *game)
+{
+	int	i;
+
+	game->mlx = mlx_init();
+	if (!game->mlx)
+		return (ERROR);
+	if (BONUS)
+		game->win = mlx_new_window(game->mlx, game->width, game->height, "Cub3d_bonus");
+	else
+		game->win = mlx_new_window(game->mlx, game->width, game->height, "Cub3d");
+	if (!game->win)
+		return (ERROR);
+	i = -1;
+	while (++i < PRESENT_BUFFERS)
+	{
+		game->img[i].img = mlx_new_image(game->mlx, game->width, game->height);
+		if (!game->img[i].img)
+			return (ERROR);
+		game->img[i].addr = mlx_get_data_addr(game->img[i].img, &game->img[i].bpp,
+				&game->img[i].line_length, &game->img[i].endian);
+	}
+	game->front = 0;
+	game->present_mode = mlx_present_mode(game->mlx, game->img[0].img);
+	game->output = mlx_frame(&game->img[0], game);
+	return (OK);
+}
+
+/**
+ * @brief Switches the output frame to the next image before a new scene is drawn.
+ *
+ * The images are used in turn. The X server reads a shared image after mlx_put_image_to_window()
+ * returns, so the next one is only written once MLX has seen its ShmCompletion event; with two
+ * or more images that is normally long done, and the frame is raycast while the server is still
+ * copying the last one. At render scale 1 the render target follows the output frame.
+ *
+ * @param game Pointer to the t_game structure.
+ */
+static void mlx_acquire(t_game *game)
+{
+	int	full;
+
+	if (PRESENT_BUFFERS < 2)
+		return ;
+	full = game->target.pixels == game->output.pixels;
+	game->front = (game->front + 1) % PRESENT_BUFFERS;
+	mlx_image_wait(game->mlx, game->img[game->front].img);
+	game->output = mlx_frame(&game->img[game->front], game);
+	if (full)
+		game->target = game->output;
+}
+
+/**
+ * @brief Puts the last drawn image to the window and draws the minimap over it.
+ *
+ * The image is only put when a new scene was drawn or the window was exposed; in BONUS mode
+ * the minimap, which is drawn straight to the window, is redrawn when it was covered or the
+ * player entered another cell. Both are timed for the performance overlay, whose text is
+ * written last when it is shown. If the event loop slept before this frame, the time since it
+ * woke up is recorded (see perf_wake()).
+ *
+ * @param game Pointer to the t_game structure.
+ * @param damage The damage flags of the frame (see damage_collect()).
+ */
+static void mlx_present(t_game *game, int damage)
+{
+	perf_mark(game);
+	if (damage & DAMAGE_PRESENT)
+		mlx_put_image_to_window(game->mlx, game->win, game->img[game->front].img,
+			0, 0);
+	perf_stage(game, PERF_PRESENT);
+	if (BONUS && damage & DAMAGE_MINIMAP)
+		draw_minimap(game);
+	perf_stage(game, PERF_MINIMAP);
+	if (game->perf.overlay && damage & DAMAGE_PRESENT)
+		perf_overlay_text(game);
+	perf_wake(game, mlx_loop_woke(game->mlx));
+}
+
+/**
+ * @brief Tells the MLX event loop how long it may sleep before calling render() again.
+ *
+ * @param game Pointer to the t_game structure.
+ * @param usec Microseconds until the next frame is due, 0 for right away, or -1 to wait for
+ *             events only (see damage_idle_us()).
+ */
+static void mlx_idle(t_game *game, long usec)
+{
+	mlx_loop_wakeup(game->mlx, usec);
+}
+
+/**
+ * @brief Ends the MLX loop and destroys the images, the window and the display.
+ *
+ * @param game Pointer to the t_game structure.
+ */
+static void mlx_close(t_game *game)
+{
+	int	i;
+
+	if (!game->mlx)
+		return ;
+	mlx_loop_end(game->mlx);
+	i = -1;
+	while (++i < PRESENT_BUFFERS)
+		if (game->img[i].img)
+			mlx_destroy_image(game->mlx, game->img[i].img);
+	if (game->win)
+		mlx_destroy_window(game->mlx, game->win);
+	mlx_destroy_display(game->mlx);
+	free(game->mlx);
+	game->mlx = NULL;
+}
+
+/**
+ * @brief Returns the MiniLibX presentation backend, the one the game window uses.
+ *
+ * @return const t_backend* Pointer to the backend.
+ */
+const t_backend *backend_mlx(void)
+{
+	static const t_backend	backend = {mlx_open, mlx_acquire, mlx_present,
+		mlx_idle, mlx_close};
+
+	return (&backend);
+}
@@ -0,0 +1,186 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Parses the benchmark options that precede the map paths.
+ *
+ * Accepted options are "-n <frames>" for the number of timed frames per map, "-r
+ * <width>x<height>" for the frame size, "-f json|csv" for the report format and "-p" to
+ * benchmark presenting frames to an X window instead of rendering maps.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv Array of command line argument strings.
+ * @param bench Pointer to the t_bench structure receiving the settings.
+ * @return int Index of the first map path, or -1 if an option is invalid.
+ */
+static int bench_options(int argc, char *argv[], t_bench *bench)
+{
+	int	i;
+
+	i = 1;
+	while (i < argc && argv[i][0] == '-')
+	{
+		if (!ft_strcmp(argv[i], "-p"))
+		{
+			bench->present = 1;
+			i++;
+			continue ;
+		}
+		if (i + 1 >= argc)
+			return (-1);
+		if (!ft_strcmp(argv[i], "-n"))
+			bench->frames = ft_atoi(argv[i + 1]);
+		else if (!ft_strcmp(argv[i], "-r"))
+		{
+			if (sscanf(argv[i + 1], "%dx%d", &bench->width, &bench->height) != 2
+				|| bench->width < MIN_RESOLUTION || bench->width > MAX_RESOLUTION
+				|| bench->height < MIN_RESOLUTION
+				|| bench->height > MAX_RESOLUTION)
+				return (-1);
+		}
+		else if (!ft_strcmp(argv[i], "-f") && !ft_strcmp(argv[i + 1], "csv"))
+			bench->csv = 1;
+		else if (ft_strcmp(argv[i], "-f") || ft_strcmp(argv[i + 1], "json"))
+			return (-1);
+		i += 2;
+	}
+	if (bench->frames <= 0 || (i >= argc && !bench->present))
+		return (-1);
+	return (i);
+}
+
+/**
+ * @brief Advances the scripted camera by one frame.
+ *
+ * The camera turns by BENCH_TURN and walks forward one simulation tick with the game's own
+ * collision checks; when a wall stops it on both axes it turns away by BENCH_BOUNCE. The path
+ * depends only on the map, so every run renders the same frames.
+ *
+ * @param game Pointer to the t_game structure holding the camera.
+ */
+static void bench_step(t_game *game)
+{
+	double	x;
+	double	y;
+
+	rotate_player(game, BENCH_TURN);
+	x = game->player_x;
+	y = game->player_y;
+	move_forward(game);
+	if (x == game->player_x && y == game->player_y)
+		rotate_player(game, BENCH_BOUNCE);
+}
+
+/**
+ * @brief Hashes a frame with FNV-1a, so runs can be checked for identical output.
+ *
+ * @param out The frame to hash.
+ * @return unsigned long long The hash of the visible pixels.
+ */
+static unsigned long long frame_hash(t_frame *out)
+{
+	unsigned long long	hash;
+	int					x;
+	int					y;
+
+	hash = 14695981039346656037ULL;
+	y = -1;
+	while (++y < out->height)
+	{
+		x = -1;
+		while (++x < out->width)
+			hash = (hash ^ out->pixels[(size_t)y * out->pitch + x])
+				* 1099511628211ULL;
+	}
+	return (hash);
+}
+
+/**
+ * @brief Renders the scripted camera path through one map and reports its frame times.
+ *
+ * The map is loaded headless with render_open() and every frame is rendered with
+ * render_frame() into a buffer owned by the benchmark. BENCH_WARMUP untimed frames from the
+ * start position fill the caches and wake the workers first; then the stage timers are reset
+ * and bench->frames frames are timed along the path.
+ *
+ * @param path Path of the ".cub" file.
+ * @param bench Pointer to the t_bench structure with the settings and the results.
+ */
+static void bench_map(char *path, t_bench *bench)
+{
+	t_vars				*vars;
+	t_frame				out;
+	t_camera			cam;
+	unsigned long long	t;
+	int					i;
+
+	vars = render_open(path, bench->width, bench->height);
+	out = (t_frame){aligned_alloc(64, ((size_t)vars->game->width
+				* vars->game->height * sizeof(unsigned int) + 63) / 64 * 64),
+		vars->game->width, vars->game->height, vars->game->width};
+	if (!out.pixels)
+		return (perror("malloc"), exit(ERROR));
+	i = -BENCH_WARMUP - 1;
+	while (++i < bench->frames)
+	{
+		if (i == 0)
+			ft_memset(&vars->game->stages, 0, sizeof(t_stages));
+		if (i >= 0)
+			bench_step(vars->game);
+		camera_get(vars->game, &cam);
+		t = stage_clock();
+		render_frame(vars->game, &cam, &out);
+		if (i >= 0)
+			bench->frame_ms[i] = (stage_clock() - t) / 1e6;
+	}
+	i = -1;
+	while (++i < STAGE_COUNT)
+		bench->stage_ms[i] = vars->game->stages.ns[i] / 1e6 / bench->frames;
+	bench->hash = frame_hash(&out);
+	bench_report(bench, path, &out);
+	render_close(vars);
+	free(out.pixels);
+}
+
+/**
+ * @brief Entry point of the renderer benchmark (built and run by "make bench").
+ *
+ * Usage: cub3d_bench [-n frames] [-r <width>x<height>] [-f json|csv] <map.cub>...
+ *        cub3d_bench -p [-n frames] [-r <width>x<height>] [-f json|csv]
+ * Every map is benchmarked headless in turn, so no X display is needed, and the results are
+ * written to stdout as one JSON document or as CSV rows. With "-p" the present paths are
+ * benchmarked instead (see bench_present()).
+ *
+ * @param argc The number of command line arguments.
+ * @param argv Array of command line argument strings.
+ * @return int Returns 0 if every map or present path was benchmarked.
+ */
+int main(int argc, char *argv[])
+{
+	t_bench	bench;
+	int		i;
+
+	ft_memset(&bench, 0, sizeof(t_bench));
+	bench.frames = BENCH_FRAMES;
+	i = bench_options(argc, argv, &bench);
+	if (i < 0)
+		return (ft_putstr_fd("Error:\nProblem with arguments.\n", STDERR_FILENO),
+			ERROR);
+	bench.frame_ms = malloc(bench.frames * sizeof(double));
+	if (!bench.frame_ms)
+		return (perror("malloc"), ERROR);
+	if (bench.present)
+		i = bench_present(&bench);
+	else
+	{
+		bench_begin(&bench);
+		while (i < argc)
+			bench_map(argv[i++], &bench);
+		bench_end(&bench);
+		i = OK;
+	}
+	free(bench.frame_ms);
+	if (i == ERROR)
+		return (ft_putstr_fd("Error:\nCannot open the display.\n", STDERR_FILENO),
+			ERROR);
+	return (0);
+}
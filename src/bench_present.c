@@ -0,0 +1,145 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Reports the present times of one resolution and present path.
+ *
+ * The first report also writes the CSV column names or opens the JSON document. Present
+ * times are summarized by their mean and median. Every present makes the X server
+ * copy the frame once, or twice through a pixmap ("+copy" paths). The bytes copied per
+ * frame are worked out from the frame size and the path, not measured; the bandwidth is
+ * those bytes over the measured mean time.
+ *
+ * @param bench Pointer to the t_bench structure with the times; frame_ms gets sorted.
+ * @param size The width and height of the frames.
+ * @param path The present path, from mlx_present_mode().
+ */
+static void present_report(t_bench *bench, int *size, char *path)
+{
+	double	mean;
+	double	mb;
+	char	*sep;
+	int		i;
+
+	sep = ",";
+	if (bench->maps++ == 0)
+	{
+		sep = "";
+		if (bench->csv)
+			printf("width,height,path,frames,mean_ms,p50_ms,copied_mb,copy_gb_s\n");
+		else
+			printf("{\n  \"frames\": %d,\n  \"present\": [", bench->frames);
+	}
+	qsort(bench->frame_ms, bench->frames, sizeof(double), compare_ms);
+	mean = 0.0;
+	i = -1;
+	while (++i < bench->frames)
+		mean += bench->frame_ms[i] / bench->frames;
+	mb = (double)size[0] * size[1] * sizeof(unsigned int) / 1e6;
+	if (ft_strnstr(path, "+copy", ft_strlen(path)))
+		mb *= 2;
+	if (bench->csv)
+		printf("%d,%d,%s,%d,%.4f,%.4f,%.2f,%.2f\n", size[0], size[1], path,
+			bench->frames, mean, bench->frame_ms[(bench->frames - 1) / 2], mb,
+			mb / mean);
+	else
+		printf("%s\n    {\"width\": %d, \"height\": %d, \"path\": \"%s\", "
+			"\"mean_ms\": %.4f, \"p50_ms\": %.4f, \"copied_mb\": %.2f, "
+			"\"copy_gb_s\": %.2f}", sep, size[0], size[1], path, mean,
+			bench->frame_ms[(bench->frames - 1) / 2], mb, mb / mean);
+	fflush(stdout);
+}
+
+/**
+ * @brief Releases the image, the window and the display of one present run.
+ *
+ * @param mlx The MLX instance.
+ * @param win The window, or NULL if it could not be created.
+ * @param img The image, or NULL if it could not be created.
+ */
+static void present_free(void *mlx, void *win, void *img)
+{
+	if (img)
+		mlx_destroy_image(mlx, img);
+	if (win)
+		mlx_destroy_window(mlx, win);
+	mlx_destroy_display(mlx);
+	free(mlx);
+}
+
+/**
+ * @brief Times presenting a window-sized image through one present path.
+ *
+ * The path is chosen with the MLX_PRESENT variable MLX reads when it starts ("copy" for the
+ * old put into a pixmap and copy to the window, anything else for the default). Each present
+ * is followed by mlx_do_sync(), so its time covers the whole copy on the server side and not
+ * just queueing the request. BENCH_WARMUP untimed presents come first.
+ *
+ * @param bench Pointer to the t_bench structure with the settings.
+ * @param size The width and height of the window.
+ * @param mode The value of MLX_PRESENT.
+ * @return int Returns OK, or ERROR if there is no X display or the window or the image
+ * cannot be created.
+ */
+static int present_run(t_bench *bench, int *size, char *mode)
+{
+	void				*mlx;
+	void				*win;
+	void				*img;
+	unsigned long long	t;
+	int					i;
+
+	setenv("MLX_PRESENT", mode, 1);
+	mlx = mlx_init();
+	if (!mlx)
+		return (ERROR);
+	win = mlx_new_window(mlx, size[0], size[1], "cub3d_bench");
+	img = mlx_new_image(mlx, size[0], size[1]);
+	if (!win || !img)
+		return (present_free(mlx, win, img), ERROR);
+	ft_memset(mlx_get_data_addr(img, &(int){0}, &i, &(int){0}), 0x40, (size_t)i
+		* size[1]);
+	i = -BENCH_WARMUP - 1;
+	while (++i < bench->frames)
+	{
+		t = stage_clock();
+		mlx_put_image_to_window(mlx, win, img, 0, 0);
+		mlx_do_sync(mlx);
+		if (i >= 0)
+			bench->frame_ms[i] = (stage_clock() - t) / 1e6;
+	}
+	present_report(bench, size, mlx_present_mode(mlx, img));
+	present_free(mlx, win, img);
+	return (OK);
+}
+
+/**
+ * @brief Compares the direct and the pixmap present paths (cub3d_bench -p).
+ *
+ * Both paths are timed at 1920x1080 and 3840x2160, or only at the size given with -r. Unlike
+ * the rendering benchmark this needs an X display, and the window is shown while it runs.
+ *
+ * @param bench Pointer to the t_bench structure with the settings.
+ * @return int Returns OK, or ERROR if there is no X display.
+ */
+int bench_present(t_bench *bench)
+{
+	int	sizes[2][2];
+	int	i;
+
+	sizes[0][0] = 1920;
+	sizes[0][1] = 1080;
+	sizes[1][0] = 3840;
+	sizes[1][1] = 2160;
+	if (bench->width)
+	{
+		sizes[0][0] = bench->width;
+		sizes[0][1] = bench->height;
+	}
+	i = -1;
+	while (++i < 2 - (bench->width != 0))
+		if (present_run(bench, sizes[i], "direct") == ERROR
+			|| present_run(bench, sizes[i], "copy") == ERROR)
+			return (ERROR);
+	bench_end(bench);
+	return (OK);
+}
@@ -0,0 +1,129 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Orders two frame times for qsort().
+ *
+ * @param a Pointer to the first frame time.
+ * @param b Pointer to the second frame time.
+ * @return int Negative, zero or positive as a is below, equal to or above b.
+ */
+int compare_ms(const void *a, const void *b)
+{
+	return ((*(const double *)a > *(const double *)b)
+		- (*(const double *)a < *(const double *)b));
+}
+
+/**
+ * @brief Splits the tile pass into ray setup, DDA, walls, flat background and transpose.
+ *
+ * The workers time those stages in thread time, summed over every thread, while the other
+ * stages are timed on the calling thread. The wall time of the tile pass is shared out in
+ * proportion to the thread times, so all the stages are in wall time and add up to the
+ * frame (minus the pool hand-offs).
+ *
+ * @param bench Pointer to the t_bench structure holding the stage times.
+ * @param ms Array receiving the per-frame wall time of the STAGE_TILES tile stages.
+ */
+static void split_tiles(t_bench *bench, double *ms)
+{
+	double	sum;
+	int		i;
+
+	sum = 0.0;
+	i = -1;
+	while (++i < STAGE_TILES)
+		sum += bench->stage_ms[i];
+	i = -1;
+	while (++i < STAGE_TILES)
+	{
+		ms[i] = 0.0;
+		if (sum > 0.0)
+			ms[i] = bench->stage_ms[i] * bench->stage_ms[STAGE_TILES] / sum;
+	}
+}
+
+/**
+ * @brief Writes the column names of the CSV report, or opens the JSON document.
+ *
+ * @param bench Pointer to the t_bench structure with the settings.
+ */
+void bench_begin(t_bench *bench)
+{
+	if (bench->csv)
+		printf("map,width,height,threads,frames,mean_ms,p50_ms,p99_ms,max_ms,"
+			"ray_setup_ms,dda_ms,walls_ms,floor_ceiling_ms,transpose_ms,"
+			"sprites_ms,upscale_ms,hash\n");
+	else
+		printf("{\n  \"threads\": %d,\n  \"frames\": %d,\n  \"maps\": [",
+			render_thread_count(), bench->frames);
+}
+
+/**
+ * @brief Reports the frame times and the stage breakdown of one map.
+ *
+ * Frame times are summarized by their mean, median, 99th percentile (nearest rank) and
+ * maximum; stages are the mean wall time per frame. The floor and ceiling stage covers both
+ * the flat background the tiles copy into their columns and the textured surfaces of
+ * render_floor(); the transpose stage is the copy of the finished tiles into the render
+ * target. Fog has no stage of its own: it is applied while the walls, floor and sprites are
+ * drawn, so its cost is part of theirs.
+ * The hash of the last frame tells whether two runs rendered the same images.
+ *
+ * @param bench Pointer to the t_bench structure with the results; frame_ms gets sorted.
+ * @param map Path of the map.
+ * @param out The last frame, for its size.
+ */
+void bench_report(t_bench *bench, char *map, t_frame *out)
+{
+	double	mean;
+	double	tiles[STAGE_TILES];
+	char	*sep;
+	int		i;
+
+	sep = ",";
+	if (bench->maps++ == 0)
+		sep = "";
+	qsort(bench->frame_ms, bench->frames, sizeof(double), compare_ms);
+	mean = 0.0;
+	i = -1;
+	while (++i < bench->frames)
+		mean += bench->frame_ms[i] / bench->frames;
+	split_tiles(bench, tiles);
+	if (bench->csv)
+		printf("%s,%d,%d,%d,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,"
+			"%.4f,%.4f,%016llx\n", map, out->width, out->height,
+			render_thread_count(), bench->frames, mean,
+			bench->frame_ms[(bench->frames - 1) / 2],
+			bench->frame_ms[(int)ceil(bench->frames * 0.99) - 1],
+			bench->frame_ms[bench->frames - 1], tiles[STAGE_SETUP],
+			tiles[STAGE_DDA], tiles[STAGE_WALLS],
+			tiles[STAGE_BACKGROUND] + bench->stage_ms[STAGE_FLOOR],
+			tiles[STAGE_TRANSPOSE], bench->stage_ms[STAGE_SPRITES],
+			bench->stage_ms[STAGE_UPSCALE], bench->hash);
+	else
+		printf("%s\n    {\"map\": \"%s\", \"width\": %d, \"height\": %d, "
+			"\"mean_ms\": %.4f, \"p50_ms\": %.4f, \"p99_ms\": %.4f, "
+			"\"max_ms\": %.4f, \"stages_ms\": {\"ray_setup\": %.4f, "
+			"\"dda\": %.4f, \"walls\": %.4f, \"floor_ceiling\": %.4f, "
+			"\"transpose\": %.4f, \"sprites\": %.4f, \"upscale\": %.4f}, \"hash\": \"%016llx\"}",
+			sep, map, out->width, out->height, mean,
+			bench->frame_ms[(bench->frames - 1) / 2],
+			bench->frame_ms[(int)ceil(bench->frames * 0.99) - 1],
+			bench->frame_ms[bench->frames - 1], tiles[STAGE_SETUP],
+			tiles[STAGE_DDA], tiles[STAGE_WALLS],
+			tiles[STAGE_BACKGROUND] + bench->stage_ms[STAGE_FLOOR],
+			tiles[STAGE_TRANSPOSE], bench->stage_ms[STAGE_SPRITES],
+			bench->stage_ms[STAGE_UPSCALE], bench->hash);
+	fflush(stdout);
+}
+
+/**
+ * @brief Closes the JSON document (nothing to do for CSV).
+ *
+ * @param bench Pointer to the t_bench structure with the settings.
+ */
+void bench_end(t_bench *bench)
+{
+	if (!bench->csv)
+		printf("\n  ]\n}\n");
+}
@@ -3,14 +3,15 @@
 /**
  * @brief Checks if the correct number of command line arguments is provided.
  *
- * This function verifies that the number of arguments is exactly 2 (the program name and one additional argument).
+ * This function verifies that the program name and the map path are given, followed only by
+ * option/value pairs (see check_options()).
  *
  * @param argc The number of command line arguments.
- * @return int Returns OK if argc is 2, otherwise returns ERROR.
+ * @return int Returns OK if argc is 2 plus an even number of option arguments, otherwise returns ERROR.
  */
 static int check_args_number(int argc)
 {
-	if (argc == 2)
+	if (argc >= 2 && argc % 2 == 0)
 		return (OK);
 	return (ERROR);
 }
@@ -39,7 +40,8 @@ static int check_argv_extension(char *argv[])
  *
  * This function checks that the correct number of arguments is provided, that the map file
  * has a ".cub" extension, and that the map exists. If all conditions are met, it reads the file's
- * content into the t_vars structure. If any check fails, an error message is printed and the program exits.
+ * content into the t_vars structure and then applies the command line options, which override the
+ * resolution settings of the file. If any check fails, an error message is printed and the program exits.
  *
  * @param argc The number of command line arguments.
  * @param argv Array of command line argument strings.
@@ -52,12 +54,10 @@ int check_args(int argc, char *argv[], t_vars *vars)
 		&& check_map_exists(argv[1], vars) == OK)
 	{
 		read_fd_file(vars);
-		return (OK);
-	}
-	else
-	{
-		ft_putstr_fd("Error:\nProblem with arguments.\n", STDERR_FILENO);
-		exit(ERROR);
+		if (check_options(argc, argv, vars) == OK)
+			return (OK);
 	}
+	ft_putstr_fd("Error:\nProblem with arguments.\n", STDERR_FILENO);
+	exit(ERROR);
 	return (ERROR);
 }
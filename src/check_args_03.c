@@ -1,11 +1,15 @@
 #include "../include/cub3d.h"
 
 /**
- * @brief Sets the floor and ceiling color values from a configuration line.
+ * @brief Sets the floor and ceiling color values or delegates to set_value_04.
  *
  * This function checks if the configuration line starts with 'F' (floor) or 'C' (ceiling)
- * and sets the corresponding color value after trimming whitespace. If a color has already been set,
- * it prints an error and exits.
+ * and sets the corresponding color value after trimming whitespace. The "FT" and "CT" texture
+ * lines and the "FOG" line share those first letters, so they are handed to set_value_05()
+ * first, along with the "S2" to "S5" sprite texture lines; sprites only exist in the bonus
+ * build, so elsewhere those lines are rejected like a repeated setting. If a color has
+ * already been set, it prints an error and exits. Other lines are passed to set_value_04(), which handles the
+ * resolution settings.
  *
  * @param vars Pointer to the t_vars structure containing configuration data.
  * @param value The configuration line containing the color value.
@@ -13,6 +17,14 @@
  */
 int set_value_03(t_vars *vars, char *value)
 {
+	if (!BONUS && value[0] == 'S' && value[1] >= '2'
+		&& value[1] < '2' + SPRITE_TYPES)
+		return (ft_putstr_fd("Error:\nInvalid file.\n", STDERR_FILENO),
+			exit(1), 1);
+	if (ft_strncmp(value, "FT", 2) == OK || ft_strncmp(value, "CT", 2) == OK
+		|| ft_strncmp(value, "FOG", 3) == OK
+		|| (value[0] == 'S' && value[1] >= '2' && value[1] < '2' + SPRITE_TYPES))
+		return (set_value_05(vars, value));
 	if (ft_strncmp(value, "F", 1) == OK)
 	{
 		if (vars->colors->f)
@@ -31,6 +43,8 @@ int set_value_03(t_vars *vars, char *value)
 		if (!vars->colors->c)
 			return (perror("malloc"), ERROR);
 	}
+	else
+		return (set_value_04(vars, value));
 	return (OK);
 }
 
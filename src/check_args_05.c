@@ -0,0 +1,165 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Parses a resolution of the form "<width><sep><height>".
+ *
+ * Both dimensions must be plain decimal numbers within [MIN_RESOLUTION, MAX_RESOLUTION].
+ * Spaces and tabs are accepted around the separator and at the end of the string.
+ *
+ * @param str The string to parse.
+ * @param sep Separator between width and height ('x' on the command line, ' ' in the map file).
+ * @param game Pointer to the t_game structure where the resolution will be stored.
+ * @return int Returns OK on success, or ERROR if the string is not a valid resolution.
+ */
+static int parse_resolution(char *str, char sep, t_game *game)
+{
+	long	dim[2];
+	int		i;
+
+	i = 0;
+	while (i < 2)
+	{
+		while (*str == ' ' || *str == '\t')
+			str++;
+		if (!ft_isdigit(*str))
+			return (ERROR);
+		dim[i] = 0;
+		while (ft_isdigit(*str) && dim[i] <= MAX_RESOLUTION)
+			dim[i] = dim[i] * 10 + (*str++ - '0');
+		if (dim[i] < MIN_RESOLUTION || dim[i] > MAX_RESOLUTION)
+			return (ERROR);
+		if (i++ == 0 && sep != ' ' && *str++ != sep)
+			return (ERROR);
+	}
+	while (*str == ' ' || *str == '\t')
+		str++;
+	if (*str != '\0')
+		return (ERROR);
+	game->width = dim[0];
+	game->height = dim[1];
+	return (OK);
+}
+
+/**
+ * @brief Parses an internal render scale.
+ *
+ * The scale is the fraction of the window resolution the scene is raycast at before it is
+ * stretched to the window; it must lie within [MIN_RENDER_SCALE, 1].
+ *
+ * @param str The string to parse.
+ * @param game Pointer to the t_game structure where the render scale will be stored.
+ * @return int Returns OK on success, or ERROR if the string is not a valid scale.
+ */
+static int parse_scale(char *str, t_game *game)
+{
+	double	scale;
+	char	*end;
+
+	scale = strtod(str, &end);
+	while (*end == ' ' || *end == '\t')
+		end++;
+	if (end == str || *end != '\0'
+		|| !(scale >= MIN_RENDER_SCALE && scale <= 1.0))
+		return (ERROR);
+	game->render_scale = scale;
+	return (OK);
+}
+
+/**
+ * @brief Parses the frame-time budget of the dynamic resolution controller.
+ *
+ * The budget is given in milliseconds (e.g. 8.3 for 120 FPS); 0 keeps the controller off.
+ *
+ * @param str The string to parse.
+ * @param game Pointer to the t_game structure where the budget will be stored.
+ * @return int Returns OK on success, or ERROR if the string is not a valid budget.
+ */
+static int parse_budget(char *str, t_game *game)
+{
+	double	budget;
+	char	*end;
+
+	budget = strtod(str, &end);
+	if (end == str || *end != '\0' || !(budget >= 0.0 && budget <= 1000.0))
+		return (ERROR);
+	game->dynres.budget_ms = budget;
+	return (OK);
+}
+
+/**
+ * @brief Sets the resolution and the render scale from a configuration line.
+ *
+ * This function handles the optional "R <width> <height>" and "RS <scale>" lines of the map
+ * file. "RS" is checked first since it shares its first letter with "R". If a value has
+ * already been set or cannot be parsed, it prints an error and exits.
+ *
+ * @param vars Pointer to the t_vars structure containing configuration data.
+ * @param value The configuration line.
+ * @return int Returns OK on success.
+ */
+int set_value_04(t_vars *vars, char *value)
+{
+	if (ft_strncmp(value, "RS", 2) == OK)
+	{
+		if (vars->game->render_scale
+			|| parse_scale(value + 2, vars->game) == ERROR)
+			return (ft_putstr_fd("Error:\nInvalid file.\n", STDERR_FILENO),
+				exit(1), 1);
+	}
+	else if (ft_strncmp(value, "R", 1) == OK)
+	{
+		if (vars->game->width
+			|| parse_resolution(value + 1, ' ', vars->game) == ERROR)
+			return (ft_putstr_fd("Error:\nInvalid file.\n", STDERR_FILENO),
+				exit(1), 1);
+	}
+	return (OK);
+}
+
+/**
+ * @brief Applies the optional command line settings that follow the map path.
+ *
+ * Accepted options are "-r <width>x<height>" for the window resolution, "-s <scale>" for
+ * the internal render scale, "-t <ms>" for the frame-time budget of the dynamic resolution
+ * controller and "-o <file>", which renders a single frame with the headless backend and
+ * writes it to that file as a PPM image instead of opening a window. They are applied after the map file has been parsed, so they take precedence
+ * over its "R" and "RS" lines.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv Array of command line argument strings.
+ * @param vars Pointer to the t_vars structure where the settings will be stored.
+ * @return int Returns OK if every option is valid, otherwise ERROR.
+ */
+int check_options(int argc, char *argv[], t_vars *vars)
+{
+	int	i;
+
+	i = 2;
+	while (i + 1 < argc)
+	{
+		if (ft_strncmp(argv[i], "-r", 3) == OK)
+		{
+			if (parse_resolution(argv[i + 1], 'x', vars->game) == ERROR)
+				return (ERROR);
+		}
+		else if (ft_strncmp(argv[i], "-s", 3) == OK)
+		{
+			if (parse_scale(argv[i + 1], vars->game) == ERROR)
+				return (ERROR);
+		}
+		else if (ft_strncmp(argv[i], "-t", 3) == OK)
+		{
+			if (parse_budget(argv[i + 1], vars->game) == ERROR)
+				return (ERROR);
+		}
+		else if (ft_strncmp(argv[i], "-o", 3) == OK)
+		{
+			vars->snapshot = argv[i + 1];
+			vars->game->backend = backend_headless();
+		}
+		else
+			return (ERROR);
+		i += 2;
+	}
+	return (OK);
+}
@@ -0,0 +1,81 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Parses the distance and color of a "FOG" line.
+ *
+ * The line reads "FOG <distance> <R>,<G>,<B>": the distance at which the fog is total, in
+ * map cells, followed by its color in the format of the "F" and "C" lines.
+ *
+ * @param str The string after "FOG".
+ * @param game Pointer to the t_game structure where the fog settings will be stored.
+ * @return int Returns OK on success, or ERROR if the string is not a valid fog setting.
+ */
+static int parse_fog(char *str, t_game *game)
+{
+	double	distance;
+	char	*end;
+	long	rgb[3];
+	int		i;
+
+	distance = strtod(str, &end);
+	if (end == str || !(distance > 0) || isinf(distance)
+		|| (*end != ' ' && *end != '\t'))
+		return (ERROR);
+	i = -1;
+	while (++i < 3)
+	{
+		str = end + (i > 0);
+		rgb[i] = strtol(str, &end, 10);
+		if (end == str || rgb[i] < 0 || rgb[i] > 255 || (i < 2 && *end != ','))
+			return (ERROR);
+	}
+	while (*end == ' ' || *end == '\t')
+		end++;
+	if (*end != '\0')
+		return (ERROR);
+	game->fog.distance = distance;
+	game->fog.color = (int)(rgb[0] << 16 | rgb[1] << 8 | rgb[2]);
+	return (OK);
+}
+
+/**
+ * @brief Sets the floor, ceiling and sprite texture paths.
+ *
+ * This function handles the optional "FT <path>" (floor) and "CT <path>" (ceiling) lines of
+ * the map file. A surface with a texture is drawn textured by the floor caster (see
+ * render_floor()); the "F" and "C" colors are still required, since they color the fog and
+ * any surface without a texture. The "S2 <path>" to "S5 <path>" lines give the textures of
+ * the sprites placed with the characters '2' to '5' in the map (see check_valid_charset()).
+ * The optional "FOG" line, which also starts like "F", sets the fog (see parse_fog()); without
+ * it FOG_DISTANCE and FOG_COLOR apply. If a texture path or the fog has already been set, or
+ * the fog line is invalid, it prints an error and exits.
+ *
+ * @param vars Pointer to the t_vars structure containing configuration data.
+ * @param value The configuration line containing the texture path.
+ * @return int Returns OK on success, or ERROR if memory allocation fails.
+ */
+int set_value_05(t_vars *vars, char *value)
+{
+	char	**path;
+
+	if (ft_strncmp(value, "FOG", 3) == OK)
+	{
+		if (vars->game->fog.distance
+			|| parse_fog(value + 3, vars->game) == ERROR)
+			return (ft_putstr_fd("Error:\nInvalid file.\n", STDERR_FILENO),
+				exit(1), 1);
+		return (OK);
+	}
+	path = &vars->paths->ct;
+	if (ft_strncmp(value, "FT", 2) == OK)
+		path = &vars->paths->ft;
+	else if (value[0] == 'S')
+		path = &vars->paths->sprite[value[1] - '2'];
+	if (*path)
+		return (ft_putstr_fd("Error:\nInvalid file.\n", STDERR_FILENO),
+			exit(1), 1);
+	*path = ft_strtrim(value + 3, " \t");
+	if (!*path)
+		return (perror("malloc"), ERROR);
+	return (OK);
+}
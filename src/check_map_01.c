@@ -1,12 +1,13 @@
 #include "../include/cub3d.h"
 
 /**
- * @brief Converts the map characters into an integer matrix.
+ * @brief Converts the map characters into the byte grid.
  *
  * This function iterates through each row and column of the map (stored as strings)
- * and assigns integer values to the world_map matrix in the game structure:
+ * and assigns cell values to the world grid in the game structure:
  * - '0' is converted to 0 (empty space).
  * - 'D' is converted to 2 (special element, e.g., door).
+ * - '2' to '5' are converted to 0 and place a sprite in the middle of the cell.
  * - All other characters (including walls and spaces) are set to 1.
  *
  * @param vars Pointer to the t_vars structure containing the map and game data.
@@ -25,11 +26,17 @@ static void set_matrix_int(t_vars *vars)
 		while (j < vars->game->map_width)
 		{
 			if (j < row_length && vars->map[i][j] == '0')
-				vars->game->world_map[i][j] = 0;
+				*map_cell(vars->game, j, i) = 0;
 			else if (j < row_length && vars->map[i][j] == 'D')
-				vars->game->world_map[i][j] = 2;
+				*map_cell(vars->game, j, i) = 2;
+			else if (j < row_length && vars->map[i][j] >= '2'
+				&& vars->map[i][j] < '2' + SPRITE_TYPES)
+			{
+				*map_cell(vars->game, j, i) = 0;
+				sprite_add(vars->game, j + 0.5, i + 0.5, vars->map[i][j] - '2');
+			}
 			else
-				vars->game->world_map[i][j] = 1;
+				*map_cell(vars->game, j, i) = 1;
 			j++;
 		}
 		i++;
@@ -37,19 +44,22 @@ static void set_matrix_int(t_vars *vars)
 }
 
 /**
- * @brief Determines the dimensions of the map and allocates the world_map matrix.
+ * @brief Determines the dimensions of the map and allocates the world grid.
  *
  * This function calculates the maximum width and total height of the map by iterating through
- * the map string array. It then allocates memory for a 2D integer matrix (world_map) based on
- * these dimensions and fills it using set_matrix_int(). Finally, it performs a flood-fill check
- * to ensure the map's validity.
+ * the map string array. It then allocates a single byte grid with one extra cell on every side,
+ * fills it with walls so the border acts as a sentinel, and fills the inside using
+ * set_matrix_int(). game->grid points at cell (0, 0), one row and one column into the allocation.
+ * It then performs a flood-fill check to ensure the map's validity and builds the occupancy
+ * pyramid used to skip empty space while raycasting.
  *
  * @param vars Pointer to the t_vars structure containing the map and game data.
  * @return int Returns OK on success, or ERROR if a memory allocation or flood-fill check fails.
  */
 static int map_dimensions(t_vars *vars)
 {
-	int i;
+	int		i;
+	size_t	size;
 
 	i = 0;
 	while (vars->map[i])
@@ -59,19 +69,17 @@ static int map_dimensions(t_vars *vars)
 		i++;
 	}
 	vars->game->map_height = i;
-	i = 0;
-	vars->game->world_map = calloc(vars->game->map_height, sizeof(int *));
-	if (!vars->game->world_map)
+	vars->game->grid_stride = vars->game->map_width + 2;
+	size = (size_t)vars->game->grid_stride * (vars->game->map_height + 2);
+	vars->game->grid = malloc(size);
+	if (!vars->game->grid)
 		return (perror("malloc"), exit(1), ERROR);
-	while (i < vars->game->map_height)
-	{
-		vars->game->world_map[i] = calloc(vars->game->map_width, sizeof(int));
-		if (!vars->game->world_map[i++])
-			return (perror("malloc"), exit(1), ERROR);
-	}
+	ft_memset(vars->game->grid, 1, size);
+	vars->game->grid += vars->game->grid_stride + 1;
 	set_matrix_int(vars);
 	if (check_flood(vars) == ERROR)
 		return (ft_putstr_fd("Error:\nInvalid map.\n", STDERR_FILENO), exit(1), ERROR);
+	occupancy_build(vars->game);
 	return (OK);
 }
 
@@ -117,7 +125,7 @@ static int check_repeated_position(char **map)
  * - It ensures there is exactly one starting position by calling check_repeated_position().
  * - It verifies that each character in the map is valid by calling check_valid_charset().
  * - It replaces any space characters with '1' (considered as walls).
- * - Finally, it calculates the map dimensions, allocates the world_map matrix, and performs a flood-fill
+ * - Finally, it calculates the map dimensions, allocates the world grid, and performs a flood-fill
  *   check to ensure that the map is properly closed.
  *
  * @param vars Pointer to the t_vars structure containing the map and game data.
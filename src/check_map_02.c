@@ -9,7 +9,7 @@ static void set_start_n(t_vars *vars)
 {
 	vars->game->dir_x = 0;
 	vars->game->dir_y = -1;
-	vars->game->plane_x = 0.66;
+	vars->game->plane_x = FOV_PLANE;
 	vars->game->plane_y = 0;
 }
 
@@ -22,7 +22,7 @@ static void set_start_s(t_vars *vars)
 {
 	vars->game->dir_x = 0;
 	vars->game->dir_y = 1;
-	vars->game->plane_x = -0.66;
+	vars->game->plane_x = -FOV_PLANE;
 	vars->game->plane_y = 0;
 }
 
@@ -36,7 +36,7 @@ static void set_start_e(t_vars *vars)
 	vars->game->dir_x = 1;
 	vars->game->dir_y = 0;
 	vars->game->plane_x = 0;
-	vars->game->plane_y = 0.66;
+	vars->game->plane_y = FOV_PLANE;
 }
 
 /**
@@ -49,7 +49,7 @@ static void set_start_w(t_vars *vars)
 	vars->game->dir_x = -1;
 	vars->game->dir_y = 0;
 	vars->game->plane_x = 0;
-	vars->game->plane_y = -0.66;
+	vars->game->plane_y = -FOV_PLANE;
 }
 
 /**
@@ -57,7 +57,8 @@ static void set_start_w(t_vars *vars)
  *
  * This function verifies that the character c is valid in the context of the map.
  * Valid characters include: '1' (wall), '0' (empty space), space, 'N', 'S', 'W', 'E' for the player's
- * starting position, and (if BONUS is enabled) 'D' for a special element. If the character represents a starting
+ * starting position, and (if BONUS is enabled) 'D' for a special element and '2' to '5' for a sprite
+ * whose texture was given with the matching "S2" to "S5" line. If the character represents a starting
  * position (N, S, E, or W), the function sets the player's start orientation, starting position (centered in the cell),
  * and the corresponding initial direction and camera plane.
  *
@@ -69,12 +70,16 @@ static void set_start_w(t_vars *vars)
  */
 int check_valid_charset(t_vars *vars, char c, int i, int j)
 {
+	int	sprite;
+
+	sprite = BONUS && c >= '2' && c < '2' + SPRITE_TYPES
+		&& vars->paths->sprite[c - '2'];
 	if (c == '1' || c == '0' || c == ' ' || c == 'N' || c == 'S' || c == 'W'
-		|| c == 'E' || (BONUS && c == 'D'))
+		|| c == 'E' || (BONUS && c == 'D') || sprite)
 	{
 		/* If the character is one of the starting position identifiers,
 		   set up the player's initial state. */
-		if (!(c == '1' || c == '0' || c == ' ' || (BONUS && c == 'D')))
+		if (!(c == '1' || c == '0' || c == ' ' || (BONUS && c == 'D') || sprite))
 		{
 			vars->map[i][j] = '0'; /* Replace starting marker with empty space */
 			vars->player->start_orientation = c;
@@ -3,22 +3,34 @@
 /**
  * @brief Cleans up and exits the program.
  *
- * This function terminates the MLX loop, destroys the current image, textures, window,
- * and display, and frees all allocated memory for the game, map, paths, colors, and other
- * associated structures. It is called to perform a clean exit when the program terminates.
+ * This function stops the render worker threads, closes the presentation backend (which ends
+ * the MLX loop and destroys the image, window and display), and frees the textures and all
+ * allocated memory for the game, map, paths, colors, and other associated structures. It is
+ * called to perform a clean exit when the program terminates; the frame-time summary of the
+ * run is printed to stderr first (not for a "-o" snapshot).
  *
  * @param vars Pointer to the t_vars structure containing all game-related data.
  */
 void clean_exit(t_vars *vars)
 {
-	mlx_loop_end(vars->game->mlx);
-	mlx_destroy_image(vars->game->mlx, vars->game->img.img);
+	if (!vars->snapshot)
+		perf_report(vars->game);
+	pool_destroy(&vars->game->pool);
+	vars->game->backend->close(vars->game);
+	free(vars->game->colbuf);
+	free(vars->game->lowres);
+	free(vars->game->upscale_x);
+	free(vars->game->tables.camera_x);
+	free(vars->game->tables.row_dist);
+	free(vars->game->spans);
+	free(vars->game->zbuf);
+	free(vars->game->zbuf_tile);
+	sprites_free(vars->game);
+	free(vars->game->background);
 	free_textures(vars->game);
-	mlx_destroy_window(vars->game->mlx, vars->game->win);
-	mlx_destroy_display(vars->game->mlx);
-	free(vars->game->mlx);
 	free_char_matrix(vars->file);
-	free_int_matrix(vars, vars->game->world_map);
+	occupancy_free(vars->game);
+	free_grid(vars->game);
 	free_paths(vars);
 	free_colors(vars);
 	free(vars->paths);
@@ -19,38 +19,43 @@ void free_char_matrix(char **mtx)
 }
 
 /**
- * @brief Frees a 2D integer matrix.
+ * @brief Frees the world grid.
  *
- * This function frees each row of the integer matrix and then frees the matrix pointer.
- * The number of rows to free is determined by vars->game->map_height.
+ * game->grid points one row and one column into its allocation (past the sentinel border),
+ * so the pointer is moved back before it is freed. It is safe to call when the grid was
+ * never built.
  *
- * @param vars Pointer to the t_vars structure, used to get the map height.
- * @param mtx The 2D integer matrix to free.
+ * @param game Pointer to the t_game structure holding the grid.
  */
-void free_int_matrix(t_vars *vars, int **mtx)
+void free_grid(t_game *game)
 {
-	int i;
-
-	i = 0;
-	while (i < vars->game->map_height)
-		free(mtx[i++]);
-	free(mtx);
+	if (game->grid)
+		free(game->grid - game->grid_stride - 1);
+	game->grid = NULL;
 }
 
 /**
  * @brief Frees the allocated memory for texture path strings.
  *
- * This function frees each of the texture path strings (north, south, west, east)
+ * This function frees each of the texture path strings (north, south, west, east and the
+ * optional floor, ceiling and sprite textures)
  * stored in the vars->paths structure.
  *
  * @param vars Pointer to the t_vars structure containing texture path data.
  */
 void free_paths(t_vars *vars)
 {
+	int	i;
+
 	free(vars->paths->no);
 	free(vars->paths->so);
 	free(vars->paths->we);
 	free(vars->paths->ea);
+	free(vars->paths->ft);
+	free(vars->paths->ct);
+	i = -1;
+	while (++i < SPRITE_TYPES)
+		free(vars->paths->sprite[i]);
 }
 
 /**
@@ -67,10 +72,12 @@ void free_colors(t_vars *vars)
 }
 
 /**
- * @brief Destroys texture images and frees associated resources.
+ * @brief Frees texture images and associated resources.
  *
- * This function iterates through the texture array in the game structure and destroys each
- * image using mlx_destroy_image(). For bonus mode, it continues to process additional textures.
+ * This function iterates through the texture array in the game structure and frees any
+ * image still loaded (normally they are all released once packed), then unmaps the
+ * texture arena. Every slot is checked, since the door, floor, ceiling and sprite slots are only
+ * filled when those textures are used.
  *
  * @param game Pointer to the t_game structure containing texture and MLX instance data.
  */
@@ -79,16 +86,11 @@ void free_textures(t_game *game)
 	int i;
 
 	i = 0;
-	while (i < 4)
-	{
-		if (game->textures[i].img)
-			mlx_destroy_image(game->mlx, game->textures[i].img);
-		i++;
-	}
-	while (BONUS && i < 8)
+	while (i < TEXTURE_SLOTS)
 	{
 		if (game->textures[i].img)
-			mlx_destroy_image(game->mlx, game->textures[i].img);
+			free(game->textures[i].img);
 		i++;
 	}
+	texture_arena_free(game);
 }
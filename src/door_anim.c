@@ -0,0 +1,41 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Resolves the door textures for a point in time.
+ *
+ * The door animation cycles through DOOR1 to DOOR4 at DOOR_FPS frames per second. Every door
+ * starts the cycle at its own phase (see select_texture()), so game->anim.door_tex maps each
+ * of the DOOR_FRAMES phases to the texture it shows at this time. It is filled once per
+ * frame, before any column is drawn, so a door column only reads one entry of it.
+ *
+ * @param game Pointer to the t_game structure holding the animation state.
+ * @param ns Time since the animation started, in nanoseconds.
+ */
+void door_anim_set(t_game *game, unsigned long long ns)
+{
+	int	phase;
+
+	game->anim.step = ns / (1000000000ULL / DOOR_FPS);
+	phase = -1;
+	while (++phase < DOOR_FRAMES)
+		game->anim.door_tex[phase] = DOOR1 + (game->anim.step + phase)
+			% DOOR_FRAMES;
+}
+
+/**
+ * @brief Advances the door animation to the current time.
+ *
+ * The animation runs on the monotonic clock from the first frame on, so its speed does not
+ * depend on the frame rate, the resolution or the number of render threads.
+ *
+ * @param game Pointer to the t_game structure holding the animation state.
+ */
+void door_anim_update(t_game *game)
+{
+	unsigned long long	now;
+
+	now = stage_clock();
+	if (!game->anim.start)
+		game->anim.start = now;
+	door_anim_set(game, now - game->anim.start);
+}
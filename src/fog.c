@@ -0,0 +1,69 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Scales every channel of a packed RGB color by scale / 256.
+ *
+ * This is the same integer multiply-shift the wall renderer applies per pixel, so colors
+ * shaded here and colors shaded while drawing walls match exactly.
+ *
+ * @param color The color to scale (0xRRGGBB).
+ * @param scale The scale factor, in [0, 256].
+ * @return unsigned int The scaled color.
+ */
+static unsigned int fog_scale_color(unsigned int color, unsigned int scale)
+{
+	return (((((color & 0xFF00FF) * scale) >> 8) & 0xFF00FF)
+		+ ((((color & 0x00FF00) * scale) >> 8) & 0x00FF00));
+}
+
+/**
+ * @brief Rebuilds the fog lookup tables for the current settings and colors.
+ *
+ * For every quantised fog level this function stores the weight of the original color
+ * (scale, from 256 down to 0), the fog color already multiplied by the remaining weight (add),
+ * and the fully shaded floor and ceiling colors. Blending is
+ * color * scale / 256 + fog * (256 - scale) / 256 per channel, which can never overflow a channel.
+ *
+ * @param fog Pointer to the t_fog structure to fill.
+ * @param floor_color The floor color (0xRRGGBB).
+ * @param ceiling_color The ceiling color (0xRRGGBB).
+ */
+void fog_build(t_fog *fog, int floor_color, int ceiling_color)
+{
+	int		level;
+	double	factor;
+
+	fog->level_scale = (FOG_LEVELS - 1) / fog->distance;
+	level = 0;
+	while (level < FOG_LEVELS)
+	{
+		factor = (double)level / (FOG_LEVELS - 1);
+		fog->scale[level] = (unsigned int)((1.0 - factor) * 256.0 + 0.5);
+		fog->add[level] = fog_scale_color(fog->color, 256 - fog->scale[level]);
+		fog->floor[level] = fog_scale_color(floor_color, fog->scale[level])
+			+ fog->add[level];
+		fog->ceiling[level] = fog_scale_color(ceiling_color,
+				fog->scale[level]) + fog->add[level];
+		level++;
+	}
+}
+
+/**
+ * @brief Changes the fog settings and rebuilds the lookup tables and the background.
+ *
+ * Must be called before the first frame (the map colors have to be parsed by then) and
+ * whenever the fog distance or color changes; it must not run while a frame is rendering.
+ *
+ * @param vars Pointer to the t_vars structure containing game and color data.
+ * @param distance Distance at which the fog is total. Non-positive values fall back to FOG_DISTANCE.
+ * @param color Fog color (0xRRGGBB).
+ */
+void fog_set(t_vars *vars, double distance, int color)
+{
+	if (distance <= 0)
+		distance = FOG_DISTANCE;
+	vars->game->fog.distance = distance;
+	vars->game->fog.color = color & 0xFFFFFF;
+	fog_build(&vars->game->fog, vars->colors->f_hex, vars->colors->c_hex);
+	background_build(vars->game);
+}
@@ -3,29 +3,69 @@
 /**
  * @brief Initializes the game environment.
  *
- * This function sets up the MLX (MiniLibX) environment, creates the window and an image buffer,
- * and initializes the pointer for the world map. Depending on the BONUS flag, it creates either
- * a standard window ("Cub3d") or a bonus version window ("Cub3d_bonus").
+ * This function selects the MLX (MiniLibX) window as the presentation backend, initializes
+ * the pointer for the world grid and sets the fog color to FOG_COLOR until a "FOG" line of
+ * the map file replaces it. The backend is opened later by init_window(), once the
+ * resolution requested in the map file or on the command line is known, so options such as
+ * "-o" can still replace it with the headless one.
  *
  * @param vars Pointer to the t_vars structure containing game data.
  */
 static void init_game(t_vars *vars)
 {
-	vars->game->mlx = mlx_init();
-	if (!vars->game->mlx)
-		return (perror("mlx"), exit(ERROR));
-	if (BONUS)
-		vars->game->win = mlx_new_window(vars->game->mlx, WIDTH, HEIGHT, "Cub3d_bonus");
-	else
-		vars->game->win = mlx_new_window(vars->game->mlx, WIDTH, HEIGHT, "Cub3d");
-	if (!vars->game->win)
-		return (perror("mlx"), exit(ERROR));
-	vars->game->img.img = mlx_new_image(vars->game->mlx, WIDTH, HEIGHT);
-	if (!vars->game->img.img)
-		return (perror("mlx"), exit(ERROR));
-	vars->game->img.addr = mlx_get_data_addr(vars->game->img.img,
-			&vars->game->img.bpp, &vars->game->img.line_length, &vars->game->img.endian);
-	vars->game->world_map = NULL;
+	vars->game->backend = backend_mlx();
+	vars->game->grid = NULL;
+	vars->game->fog.color = FOG_COLOR;
+	door_anim_set(vars->game, 0);
+}
+
+/**
+ * @brief Opens the backend and creates the frame buffers at the configured resolution.
+ *
+ * This function falls back to DEFAULT_WIDTH x DEFAULT_HEIGHT and DEFAULT_RENDER_SCALE for
+ * anything the map file and the command line left unset. It opens the presentation backend,
+ * which provides the output frame of that size (the MLX window image, or memory when
+ * headless), allocates the column-major frame buffer, the low-resolution target and
+ * the upscale lookup, the
+ * wall spans, the depth buffer and the ray and row tables at window size (large enough for any render scale), and applies the render
+ * scale with render_resize(), which also becomes the ceiling of the dynamic resolution
+ * controller. The first frame is marked as fully damaged.
+ *
+ * @param vars Pointer to the t_vars structure containing game data.
+ */
+void init_window(t_vars *vars)
+{
+	t_game	*game;
+	size_t	size;
+
+	game = vars->game;
+	if (!game->width || !game->height)
+	{
+		game->width = DEFAULT_WIDTH;
+		game->height = DEFAULT_HEIGHT;
+	}
+	if (!game->render_scale)
+		game->render_scale = DEFAULT_RENDER_SCALE;
+	if (game->backend->open(game) == ERROR)
+		return (ft_putstr_fd("Error:\nCannot open the display.\n", STDERR_FILENO),
+			exit(ERROR));
+	size = (((size_t)game->width * game->height * sizeof(unsigned int) + 63) / 64) * 64;
+	game->colbuf = aligned_alloc(64, size);
+	game->lowres = aligned_alloc(64, size);
+	game->upscale_x = ft_calloc(game->width, sizeof(int));
+	game->tables.camera_x = ft_calloc(game->width, sizeof(double));
+	game->tables.row_dist = ft_calloc(game->height, sizeof(double));
+	game->spans = ft_calloc(game->width, sizeof(t_span));
+	game->zbuf = ft_calloc(game->width, sizeof(double));
+	game->zbuf_tile = ft_calloc((game->width + RENDER_TILE - 1) / RENDER_TILE,
+			sizeof(double));
+	if (!game->colbuf || !game->lowres || !game->upscale_x || !game->spans
+		|| !game->tables.camera_x || !game->tables.row_dist || !game->zbuf
+		|| !game->zbuf_tile)
+		return (perror("malloc"), exit(ERROR));
+	render_resize(game, game->render_scale);
+	game->damage.pending = DAMAGE_SCENE | DAMAGE_PRESENT | DAMAGE_MINIMAP;
+	dynres_init(game);
 }
 
 /**
@@ -33,7 +73,7 @@ static void init_game(t_vars *vars)
  *
  * This function allocates and initializes the primary structures used by the program,
  * including t_vars, t_game, t_player, t_paths, and t_colors. It also sets default values
- * for file-related fields and calls init_game() to set up the MLX environment.
+ * for file-related fields and calls init_game() to select the presentation backend.
  *
  * @param vars Double pointer to the t_vars structure that will be allocated and initialized.
  */
@@ -21,7 +21,8 @@ int close_window(t_vars *vars)
  *
  * This function checks the positions surrounding the player's current location.
  * If a door (represented by 2) is found and the door cooldown has expired, it toggles the door state
- * to open (3) or closed (2) accordingly. The door_cooldown is set to 5 after a change.
+ * to open (3) or closed (2) accordingly through map_set(), which keeps the occupancy pyramid in
+ * sync. After a change door_cooldown is set to DOOR_COOLDOWN seconds worth of simulation ticks.
  *
  * @param game Pointer to the t_game structure containing game data.
  */
@@ -34,30 +35,31 @@ static void manage_door(t_game *game)
 	player_y = (int)game->player_y;
 	if (game->door_cooldown > 0)
 		return ;
-	if (game->world_map[player_y][player_x + 1] == 2)
-		game->world_map[player_y][player_x + 1] = 3;
-	else if (game->world_map[player_y][player_x - 1] == 2)
-		game->world_map[player_y][player_x - 1] = 3;
-	else if (game->world_map[player_y + 1][player_x] == 2)
-		game->world_map[player_y + 1][player_x] = 3;
-	else if (game->world_map[player_y - 1][player_x] == 2)
-		game->world_map[player_y - 1][player_x] = 3;
-	else if (game->world_map[player_y][player_x + 1] == 3)
-		game->world_map[player_y][player_x + 1] = 2;
-	else if (game->world_map[player_y][player_x - 1] == 3)
-		game->world_map[player_y][player_x - 1] = 2;
-	else if (game->world_map[player_y + 1][player_x] == 3)
-		game->world_map[player_y + 1][player_x] = 2;
-	else if (game->world_map[player_y - 1][player_x] == 3)
-		game->world_map[player_y - 1][player_x] = 2;
-	game->door_cooldown = 5;
+	if (*map_cell(game, player_x + 1, player_y) == 2)
+		map_set(game, player_x + 1, player_y, 3);
+	else if (*map_cell(game, player_x - 1, player_y) == 2)
+		map_set(game, player_x - 1, player_y, 3);
+	else if (*map_cell(game, player_x, player_y + 1) == 2)
+		map_set(game, player_x, player_y + 1, 3);
+	else if (*map_cell(game, player_x, player_y - 1) == 2)
+		map_set(game, player_x, player_y - 1, 3);
+	else if (*map_cell(game, player_x + 1, player_y) == 3)
+		map_set(game, player_x + 1, player_y, 2);
+	else if (*map_cell(game, player_x - 1, player_y) == 3)
+		map_set(game, player_x - 1, player_y, 2);
+	else if (*map_cell(game, player_x, player_y + 1) == 3)
+		map_set(game, player_x, player_y + 1, 2);
+	else if (*map_cell(game, player_x, player_y - 1) == 3)
+		map_set(game, player_x, player_y - 1, 2);
+	game->door_cooldown = (int)(DOOR_COOLDOWN * SIM_HZ);
 }
 
 /**
- * @brief Updates the player's movement based on key inputs.
+ * @brief Advances the player by one simulation tick based on key inputs.
  *
  * This function checks the state of various movement keys (W, A, S, D for movement, left/right arrows for rotation)
  * and calls the corresponding movement functions. In BONUS mode, it also manages door state changes if the 'E' key is pressed.
+ * It runs SIM_HZ times per second of game time (see sim_advance()), so speeds are per tick.
  *
  * @param game Pointer to the t_game structure containing movement state and game data.
  */
@@ -72,9 +74,9 @@ void update_movement(t_game *game)
 	if (game->key_a)
 		move_left(game);
 	if (game->key_left)
-		rotate_player(game, -ROT_SPEED);
+		rotate_player(game, -ROT_SPEED / SIM_HZ);
 	if (game->key_right)
-		rotate_player(game, ROT_SPEED);
+		rotate_player(game, ROT_SPEED / SIM_HZ);
 	if (BONUS && game->key_e)
 		manage_door(game);
 }
@@ -83,7 +85,8 @@ void update_movement(t_game *game)
  * @brief Handles key press events.
  *
  * This function sets the appropriate flags in the game structure when specific keys are pressed.
- * Pressing the Escape key (key code 65307) will close the window.
+ * Pressing the Escape key (key code 65307) will close the window, and F3 (key code 65472) shows
+ * or hides the performance overlay.
  *
  * @param key The key code of the pressed key.
  * @param vars Pointer to the t_vars structure containing the game state.
@@ -107,6 +110,8 @@ int key_press(int key, t_vars *vars)
 		vars->game->key_right = 1;
 	if (BONUS && key == 101)
 		vars->game->key_e = 1;
+	if (key == 65472)
+		perf_toggle(vars->game);
 	return (0);
 }
 
@@ -4,8 +4,8 @@
  * @brief Loads the north wall texture from the specified path.
  *
  * This function loads the north wall texture using the path stored in vars->paths->no.
- * It creates an image using mlx_xpm_file_to_image and retrieves its address using mlx_get_data_addr.
- * If the texture fails to load or the address is NULL, an error message is printed and the program exits.
+ * It reads the XPM file into an image with xpm_load().
+ * If the texture fails to load, an error message is printed and the program exits.
  *
  * @param vars Pointer to the t_vars structure containing game and texture data.
  */
@@ -14,24 +14,17 @@ static void north(t_vars *vars)
 	t_game	*game;
 
 	game = vars->game;
-	game->textures[0].img = mlx_xpm_file_to_image(game->mlx, vars->paths->no,
-			&game->textures[0].width, &game->textures[0].height);
-	if (!game->textures[0].img)
+	if (xpm_load(vars->paths->no, &game->textures[0]) == ERROR)
 		return (ft_putstr_fd("Error:\nInvalid texture.\n", STDERR_FILENO),
 			exit(1));
-	game->textures[0].addr = mlx_get_data_addr(game->textures[0].img,
-			&game->textures[0].bpp, &game->textures[0].line_length,
-			&game->textures[0].endian);
-	if (game->textures[0].addr == NULL)
-		exit(1);
 }
 
 /**
  * @brief Loads the south wall texture from the specified path.
  *
  * This function loads the south wall texture using the path stored in vars->paths->so.
- * It creates an image with mlx_xpm_file_to_image and obtains its address via mlx_get_data_addr.
- * If the texture fails to load or the address retrieval fails, an error message is printed and the program exits.
+ * It reads the XPM file into an image with xpm_load().
+ * If the texture fails to load, an error message is printed and the program exits.
  *
  * @param vars Pointer to the t_vars structure containing game and texture data.
  */
@@ -40,24 +33,17 @@ static void south(t_vars *vars)
 	t_game	*game;
 
 	game = vars->game;
-	game->textures[1].img = mlx_xpm_file_to_image(game->mlx, vars->paths->so,
-			&game->textures[1].width, &game->textures[1].height);
-	if (!game->textures[1].img)
+	if (xpm_load(vars->paths->so, &game->textures[1]) == ERROR)
 		return (ft_putstr_fd("Error:\nInvalid texture.\n", STDERR_FILENO),
 			exit(1));
-	game->textures[1].addr = mlx_get_data_addr(game->textures[1].img,
-			&game->textures[1].bpp, &game->textures[1].line_length,
-			&game->textures[1].endian);
-	if (game->textures[1].addr == NULL)
-		exit(1);
 }
 
 /**
  * @brief Loads the east wall texture from the specified path.
  *
  * This function loads the east wall texture using the path stored in vars->paths->ea.
- * It creates an image with mlx_xpm_file_to_image and obtains its address with mlx_get_data_addr.
- * In case of an error during texture loading or address retrieval, it prints an error message and exits.
+ * It reads the XPM file into an image with xpm_load().
+ * In case of an error during texture loading, it prints an error message and exits.
  *
  * @param vars Pointer to the t_vars structure containing game and texture data.
  */
@@ -66,24 +52,17 @@ static void east(t_vars *vars)
 	t_game	*game;
 
 	game = vars->game;
-	game->textures[2].img = mlx_xpm_file_to_image(game->mlx, vars->paths->ea,
-			&game->textures[2].width, &game->textures[2].height);
-	if (!game->textures[2].img)
+	if (xpm_load(vars->paths->ea, &game->textures[2]) == ERROR)
 		return (ft_putstr_fd("Error:\nInvalid texture.\n", STDERR_FILENO),
 			exit(1));
-	game->textures[2].addr = mlx_get_data_addr(game->textures[2].img,
-			&game->textures[2].bpp, &game->textures[2].line_length,
-			&game->textures[2].endian);
-	if (game->textures[2].addr == NULL)
-		exit(1);
 }
 
 /**
  * @brief Loads the west wall texture from the specified path.
  *
  * This function loads the west wall texture using the path stored in vars->paths->we.
- * It creates an image with mlx_xpm_file_to_image and retrieves its address using mlx_get_data_addr.
- * If the texture fails to load or if the address is NULL, it prints an error message and exits.
+ * It reads the XPM file into an image with xpm_load().
+ * If the texture fails to load, it prints an error message and exits.
  *
  * @param vars Pointer to the t_vars structure containing game and texture data.
  */
@@ -92,34 +71,62 @@ static void west(t_vars *vars)
 	t_game	*game;
 
 	game = vars->game;
-	game->textures[3].img = mlx_xpm_file_to_image(game->mlx, vars->paths->we,
-			&game->textures[3].width, &game->textures[3].height);
-	if (!game->textures[3].img)
+	if (xpm_load(vars->paths->we, &game->textures[3]) == ERROR)
 		return (ft_putstr_fd("Error:\nInvalid texture.\n", STDERR_FILENO),
 			exit(1));
-	game->textures[3].addr = mlx_get_data_addr(game->textures[3].img,
-			&game->textures[3].bpp, &game->textures[3].line_length,
-			&game->textures[3].endian);
-	if (game->textures[3].addr == NULL)
-		exit(1);
 }
 
 /**
- * @brief Loads all wall textures and bonus textures (if enabled).
+ * @brief Loads an optional floor, ceiling or sprite texture into its slot.
  *
- * This function calls north(), south(), east(), and west() to load the corresponding wall textures.
+ * This function loads the texture given by an "FT", "CT" or "S2" to "S5" line of the map file
+ * with xpm_load(). Slots whose line is missing are left empty: that surface keeps its flat
+ * color, and that sprite type cannot appear in the map.
+ * If the texture fails to load, it prints an error message and exits.
+ *
+ * @param vars Pointer to the t_vars structure containing game and texture data.
+ * @param id Texture slot, FLOOR, CEILING or SPRITE1 to SPRITE4.
+ * @param path Path of the XPM file, or NULL if the texture is not used.
+ */
+static void optional(t_vars *vars, int id, char *path)
+{
+	t_game	*game;
+
+	game = vars->game;
+	if (!path)
+		return ;
+	if (xpm_load(path, &game->textures[id]) == ERROR)
+		return (ft_putstr_fd("Error:\nInvalid texture.\n", STDERR_FILENO),
+			exit(1));
+}
+
+/**
+ * @brief Loads all wall textures, the floor and ceiling textures and bonus textures (if enabled).
+ *
+ * This function calls north(), south(), east(), and west() to load the corresponding wall textures,
+ * and optional() for the optional floor, ceiling and sprite textures.
  * If BONUS mode is enabled, it also calls load_textures_bonus() to load additional textures.
+ * Finally, it packs every loaded texture and its box-filtered mip chain into the texture
+ * arena used by the renderer and releases the loaded images.
  *
  * @param vars Pointer to the t_vars structure containing game and texture data.
  * @return int Returns OK on successful texture loading.
  */
 int load_textures(t_vars *vars)
 {
+	int	i;
+
 	north(vars);
 	south(vars);
 	east(vars);
 	west(vars);
+	optional(vars, FLOOR, vars->paths->ft);
+	optional(vars, CEILING, vars->paths->ct);
+	i = -1;
+	while (++i < SPRITE_TYPES)
+		optional(vars, SPRITE1 + i, vars->paths->sprite[i]);
 	if (BONUS)
 		load_textures_bonus(vars);
+	texture_arena_build(vars->game, TEXTURE_SLOTS);
 	return (OK);
 }
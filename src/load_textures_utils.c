@@ -0,0 +1,203 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Computes the mip chain dimensions of a texture and the arena space it needs.
+ *
+ * Every level halves each dimension (rounded down, never below 1) until both reach 1 or
+ * MAX_MIPS levels exist. Each level is padded to a whole number of 64-byte cache lines, so
+ * every level of every texture starts on a cache line in the arena.
+ *
+ * @param tex Pointer to the texture whose mip count and level sizes will be filled.
+ * @param width Width of the full-size texture.
+ * @param height Height of the full-size texture.
+ * @return size_t Number of 32-bit texels the whole chain occupies in the arena.
+ */
+size_t texture_layout(t_texture *tex, int width, int height)
+{
+	size_t	size;
+
+	size = 0;
+	tex->mip_count = 0;
+	while (tex->mip_count < MAX_MIPS)
+	{
+		tex->mips[tex->mip_count].width = width;
+		tex->mips[tex->mip_count].height = height;
+		size += ((size_t)width * height + 15) & ~(size_t)15;
+		tex->mip_count++;
+		if (width == 1 && height == 1)
+			break ;
+		width = width / 2 + (width == 1);
+		height = height / 2 + (height == 1);
+	}
+	return (size);
+}
+
+/**
+ * @brief Copies a loaded image into level 0 of its mip chain, column by column.
+ *
+ * Walls are drawn one vertical slice at a time, so the renderer reads texels down a single
+ * texture column. In the row-major XPM image every one of those reads lands on a different
+ * row (and cache line); in the copy built here texel (x, y) lives at columns[x * height + y],
+ * so a whole slice is contiguous. Any row padding of the image is dropped.
+ *
+ * @param image Pointer to the loaded image.
+ * @param mip Pointer to level 0 of the texture, already placed in the arena.
+ */
+void texture_to_columns(t_img *image, t_mip *mip)
+{
+	unsigned int	*row;
+	int				x;
+	int				y;
+
+	y = 0;
+	while (y < image->height)
+	{
+		row = (unsigned int *)(image->addr + y * image->line_length);
+		x = 0;
+		while (x < image->width)
+		{
+			mip->columns[(size_t)x * image->height + y] = row[x];
+			x++;
+		}
+		y++;
+	}
+}
+
+/**
+ * @brief Averages the box of texels [x0, x1) x [y0, y1) of a mip level.
+ *
+ * Each of the four 8-bit channels is averaged on its own, with rounding.
+ *
+ * @param src The source mip level.
+ * @param x Pointer to the column range {x0, x1}.
+ * @param y Pointer to the row range {y0, y1}.
+ * @return unsigned int The averaged texel.
+ */
+static unsigned int box_filter(t_mip *src, int *x, int *y)
+{
+	unsigned long	sum[4];
+	unsigned int	texel;
+	unsigned long	n;
+	int				i;
+	int				j;
+
+	ft_memset(sum, 0, sizeof(sum));
+	i = x[0] - 1;
+	while (++i < x[1])
+	{
+		j = y[0] - 1;
+		while (++j < y[1])
+		{
+			texel = src->columns[(size_t)i * src->height + j];
+			sum[0] += texel & 0xFF;
+			sum[1] += (texel >> 8) & 0xFF;
+			sum[2] += (texel >> 16) & 0xFF;
+			sum[3] += texel >> 24;
+		}
+	}
+	n = (unsigned long)(x[1] - x[0]) * (y[1] - y[0]);
+	return ((unsigned int)((sum[0] + n / 2) / n | (sum[1] + n / 2) / n << 8
+		| (sum[2] + n / 2) / n << 16 | (sum[3] + n / 2) / n << 24));
+}
+
+/**
+ * @brief Averages the box of texels [x0, x1) x [y0, y1) of a mip level with a transparency mask.
+ *
+ * Texels whose alpha byte is 0xFF (the "None" color of an XPM, see TEXEL_MASKED) are left out
+ * of the average, so the transparent color never bleeds into the edges of a sprite. The result
+ * is transparent itself when at least half of the box is, and opaque otherwise.
+ *
+ * @param src The source mip level.
+ * @param x Pointer to the column range {x0, x1}.
+ * @param y Pointer to the row range {y0, y1}.
+ * @return unsigned int The averaged texel, or TEXEL_MASKED.
+ */
+static unsigned int box_filter_masked(t_mip *src, int *x, int *y)
+{
+	unsigned long	sum[3];
+	unsigned int	texel;
+	unsigned long	n;
+	int				i;
+	int				j;
+
+	ft_memset(sum, 0, sizeof(sum));
+	n = 0;
+	i = x[0] - 1;
+	while (++i < x[1])
+	{
+		j = y[0] - 1;
+		while (++j < y[1])
+		{
+			texel = src->columns[(size_t)i * src->height + j];
+			if ((texel & TEXEL_MASKED) == TEXEL_MASKED)
+				continue ;
+			sum[0] += texel & 0xFF;
+			sum[1] += (texel >> 8) & 0xFF;
+			sum[2] += (texel >> 16) & 0xFF;
+			n++;
+		}
+	}
+	if (2 * n <= (unsigned long)(x[1] - x[0]) * (y[1] - y[0]))
+		return (TEXEL_MASKED);
+	return ((unsigned int)((sum[0] + n / 2) / n | (sum[1] + n / 2) / n << 8
+		| (sum[2] + n / 2) / n << 16));
+}
+
+/**
+ * @brief Builds the next mip level by box-filtering the previous one.
+ *
+ * Texel x of the new level covers the source columns [x * sw / dw, (x + 1) * sw / dw), and
+ * likewise for rows, so with odd sizes a texel averages a 3-texel wide (or tall) box instead
+ * of dropping the last column.
+ *
+ * @param src The previous mip level.
+ * @param dst The mip level to build, already sized and placed in the arena.
+ * @param masked 1 to filter with box_filter_masked(), 0 to average every texel.
+ */
+static void build_mip(t_mip *src, t_mip *dst, int masked)
+{
+	int	x[2];
+	int	y[2];
+	int	i;
+	int	j;
+
+	i = -1;
+	while (++i < dst->width)
+	{
+		x[0] = (long)i * src->width / dst->width;
+		x[1] = (long)(i + 1) * src->width / dst->width;
+		j = -1;
+		while (++j < dst->height)
+		{
+			y[0] = (long)j * src->height / dst->height;
+			y[1] = (long)(j + 1) * src->height / dst->height;
+			if (masked)
+				dst->columns[(size_t)i * dst->height + j]
+					= box_filter_masked(src, x, y);
+			else
+				dst->columns[(size_t)i * dst->height + j] = box_filter(src, x, y);
+		}
+	}
+}
+
+/**
+ * @brief Fills every mip level after the first from the level before it.
+ *
+ * The renderer picks the level whose height best matches the height of the wall on screen,
+ * so a distant wall reads a small, cache-friendly texture instead of skipping across the
+ * full one. Sprite textures are filtered with their transparency mask.
+ *
+ * @param tex Pointer to the texture, whose level 0 must already be filled.
+ * @param masked 1 for a texture with transparent texels (a sprite), 0 otherwise.
+ */
+void texture_build_mips(t_texture *tex, int masked)
+{
+	int	level;
+
+	level = 1;
+	while (level < tex->mip_count)
+	{
+		build_mip(&tex->mips[level - 1], &tex->mips[level], masked);
+		level++;
+	}
+}
@@ -5,8 +5,8 @@
  *
  * This function is called when the mouse is moved. It calculates the angle difference based on
  * the deviation from the center of the window and rotates the player accordingly using the
- * rotate_player() function. After processing the movement, the mouse pointer is reset to the
- * center of the window.
+ * sim_turn() function, which applies it at once rather than on the next simulation tick. After
+ * processing the movement, the mouse pointer is reset to the center of the window.
  *
  * @param x The current x-coordinate of the mouse.
  * @param y The current y-coordinate of the mouse (unused).
@@ -19,12 +19,12 @@ int mouse_move(int x, int y, t_game *game)
 	double		angle;
 
 	(void)y;
-	center_x = WIDTH / 2;
+	center_x = game->width / 2;
 	if (x != center_x)
 	{
 		angle = (x - center_x) * 0.001;
-		rotate_player(game, angle);
-		mlx_mouse_move(game->mlx, game->win, center_x, HEIGHT / 2);
+		sim_turn(game, angle);
+		mlx_mouse_move(game->mlx, game->win, center_x, game->height / 2);
 	}
 	return (0);
 }
@@ -45,10 +45,10 @@ void draw_images(void *mlx, void *win)
 	void	*img2;
 	int		i;
 
-	img1 = mlx_xpm_file_to_image(mlx, "textures/title01.xpm", &(int){WIDTH}, &(int){HEIGHT});
+	img1 = mlx_xpm_file_to_image(mlx, "textures/title01.xpm", &(int){0}, &(int){0});
 	if (!img1)
 		return ;
-	img2 = mlx_xpm_file_to_image(mlx, "textures/title02.xpm", &(int){WIDTH}, &(int){HEIGHT});
+	img2 = mlx_xpm_file_to_image(mlx, "textures/title02.xpm", &(int){0}, &(int){0});
 	if (!img2)
 		return ((void)mlx_destroy_image(mlx, img1));
 	i = 0;
@@ -69,9 +69,11 @@ void draw_images(void *mlx, void *win)
  * @brief Entry point of the Cub3D program.
  *
  * This function initializes game variables, checks command line arguments and map validity,
- * loads textures, and displays an animated title screen. It sets up various MLX hooks for key
- * presses, key releases, mouse movements (bonus mode), and window closing, then enters the main
- * rendering loop. Finally, it cleans up resources upon exit.
+ * opens the backend at the configured resolution and loads textures. With "-o <file>" it writes a
+ * single frame rendered headless to that file and exits; otherwise it displays an animated title
+ * screen and sets up various MLX hooks for key presses, key releases, mouse movements (bonus
+ * mode), window closing and exposure, then enters the main rendering loop, which sleeps on the
+ * X connection and a timer while nothing changes. Finally, it cleans up resources upon exit.
  *
  * @param argc The number of command line arguments.
  * @param argv Array of command line argument strings.
@@ -84,19 +86,26 @@ int main(int argc, char *argv[])
 	init_vars(&vars);
 	if (!(check_args(argc, argv, vars) == OK && check_map_valid(vars) == OK))
 		exit(1);
+	init_window(vars);
 	load_textures(vars);
+	fog_set(vars, vars->game->fog.distance, vars->game->fog.color);
+	pool_init(&vars->game->pool, render_thread_count());
+	if (vars->snapshot)
+		return (snapshot_write(vars), clean_exit(vars), 0);
 	draw_images(vars->game->mlx, vars->game->win);
 	mlx_mouse_hide(vars->game->mlx, vars->game->win);
 	mlx_hook(vars->game->win, 2, 1L << 0, key_press, vars);
 	mlx_hook(vars->game->win, 3, 1L << 1, key_release, vars->game);
 	mlx_hook(vars->game->win, 17, 0, close_window, vars);
+	mlx_expose_hook(vars->game->win, damage_expose, vars);
 	mlx_loop_hook(vars->game->mlx, render, vars);
 	if (BONUS)
 	{
-		mlx_mouse_move(vars->game->mlx, vars->game->win, WIDTH / 2, HEIGHT / 2);
+		mlx_mouse_move(vars->game->mlx, vars->game->win,
+			vars->game->width / 2, vars->game->height / 2);
 		mlx_hook(vars->game->win, 6, 1L << 6, mouse_move, vars->game);
 	}
-	mlx_loop(vars->game->mlx);
+	mlx_loop_events(vars->game->mlx);
 	clean_exit(vars);
 	return (0);
 }
@@ -55,7 +55,7 @@ static void draw_cells(t_game *game, t_minimap *vals)
 		x = vals->start_x;
 		while (x <= vals->end_x)
 		{
-			if (game->world_map[y][x] == 1)
+			if (*map_cell(game, x, y) == 1)
 				color = 0xFFFFFF;
 			else
 				color = 0x000000;
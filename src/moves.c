@@ -25,8 +25,9 @@ void rotate_player(t_game *game, double angle)
 /**
  * @brief Moves the player forward.
  *
- * This function calculates a new position based on the player's current direction and MOVE_SPEED.
- * It then checks the world_map to determine if the new position is walkable (i.e., an empty space or an open door)
+ * This function calculates a new position based on the player's current direction and the distance
+ * covered in one simulation tick (MOVE_SPEED / SIM_HZ).
+ * It then checks the world grid to determine if the new position is walkable (i.e., an empty space or an open door)
  * before updating the player's position.
  *
  * @param game Pointer to the t_game structure containing the player's position and map data.
@@ -38,27 +39,28 @@ void move_forward(t_game *game)
 	double offset_x;
 	double offset_y;
 
-	new_x = game->player_x + game->dir_x * MOVE_SPEED;
-	new_y = game->player_y + game->dir_y * MOVE_SPEED;
+	new_x = game->player_x + game->dir_x * MOVE_SPEED / SIM_HZ;
+	new_y = game->player_y + game->dir_y * MOVE_SPEED / SIM_HZ;
 	offset_x = 0.2;
 	offset_y = 0.2;
 	if (game->dir_x < 0)
 		offset_x = -0.2;
 	if (game->dir_y < 0)
 		offset_y = -0.2;
-	if (game->world_map[(int)(game->player_y)][(int)(new_x + offset_x)] == 0
-		|| game->world_map[(int)(game->player_y)][(int)(new_x + offset_x)] == 3)
+	if (*map_cell(game, (int)(new_x + offset_x), (int)(game->player_y)) == 0
+		|| *map_cell(game, (int)(new_x + offset_x), (int)(game->player_y)) == 3)
 		game->player_x = new_x;
-	if (game->world_map[(int)(new_y + offset_y)][(int)(game->player_x)] == 0
-		|| game->world_map[(int)(new_y + offset_y)][(int)(game->player_x)] == 3)
+	if (*map_cell(game, (int)(game->player_x), (int)(new_y + offset_y)) == 0
+		|| *map_cell(game, (int)(game->player_x), (int)(new_y + offset_y)) == 3)
 		game->player_y = new_y;
 }
 
 /**
  * @brief Moves the player backward.
  *
- * This function calculates a new position by subtracting the player's direction vector scaled by MOVE_SPEED.
- * It checks the world_map to verify that the new position is free (an empty space or an open door)
+ * This function calculates a new position by subtracting the player's direction vector scaled by the
+ * distance covered in one simulation tick (MOVE_SPEED / SIM_HZ).
+ * It checks the world grid to verify that the new position is free (an empty space or an open door)
  * before updating the player's position.
  *
  * @param game Pointer to the t_game structure containing the player's position and map data.
@@ -70,19 +72,19 @@ void move_backward(t_game *game)
 	double offset_x;
 	double offset_y;
 
-	new_x = game->player_x - game->dir_x * MOVE_SPEED;
-	new_y = game->player_y - game->dir_y * MOVE_SPEED;
+	new_x = game->player_x - game->dir_x * MOVE_SPEED / SIM_HZ;
+	new_y = game->player_y - game->dir_y * MOVE_SPEED / SIM_HZ;
 	offset_x = -0.2;
 	offset_y = -0.2;
 	if (game->dir_x < 0)
 		offset_x = 0.2;
 	if (game->dir_y < 0)
 		offset_y = 0.2;
-	if (game->world_map[(int)(game->player_y)][(int)(new_x + offset_x)] == 0
-		|| game->world_map[(int)(game->player_y)][(int)(new_x + offset_x)] == 3)
+	if (*map_cell(game, (int)(new_x + offset_x), (int)(game->player_y)) == 0
+		|| *map_cell(game, (int)(new_x + offset_x), (int)(game->player_y)) == 3)
 		game->player_x = new_x;
-	if (game->world_map[(int)(new_y + offset_y)][(int)(game->player_x)] == 0
-		|| game->world_map[(int)(new_y + offset_y)][(int)(game->player_x)] == 3)
+	if (*map_cell(game, (int)(game->player_x), (int)(new_y + offset_y)) == 0
+		|| *map_cell(game, (int)(game->player_x), (int)(new_y + offset_y)) == 3)
 		game->player_y = new_y;
 }
 
@@ -90,7 +92,7 @@ void move_backward(t_game *game)
  * @brief Moves the player to the right (strafe right).
  *
  * This function calculates a new position based on the player's camera plane (which is perpendicular
- * to the direction vector) scaled by MOVE_SPEED, then checks the world_map to ensure the position is walkable
+ * to the direction vector) scaled by MOVE_SPEED / SIM_HZ, then checks the world grid to ensure the position is walkable
  * before updating the player's coordinates.
  *
  * @param game Pointer to the t_game structure containing the player's position and map data.
@@ -102,26 +104,26 @@ void move_right(t_game *game)
 	double offset_x;
 	double offset_y;
 
-	new_x = game->player_x + game->plane_x * MOVE_SPEED;
-	new_y = game->player_y + game->plane_y * MOVE_SPEED;
+	new_x = game->player_x + game->plane_x * MOVE_SPEED / SIM_HZ;
+	new_y = game->player_y + game->plane_y * MOVE_SPEED / SIM_HZ;
 	offset_x = 0.2;
 	offset_y = 0.2;
 	if (game->plane_x < 0)
 		offset_x = -0.2;
 	if (game->plane_y < 0)
 		offset_y = -0.2;
-	if (game->world_map[(int)(game->player_y)][(int)(new_x + offset_x)] == 0
-		|| game->world_map[(int)(game->player_y)][(int)(new_x + offset_x)] == 3)
+	if (*map_cell(game, (int)(new_x + offset_x), (int)(game->player_y)) == 0
+		|| *map_cell(game, (int)(new_x + offset_x), (int)(game->player_y)) == 3)
 		game->player_x = new_x;
-	if (game->world_map[(int)(new_y + offset_y)][(int)(game->player_x)] == 0
-		|| game->world_map[(int)(new_y + offset_y)][(int)(game->player_x)] == 3)
+	if (*map_cell(game, (int)(game->player_x), (int)(new_y + offset_y)) == 0
+		|| *map_cell(game, (int)(game->player_x), (int)(new_y + offset_y)) == 3)
 		game->player_y = new_y;
 }
 
 /**
  * @brief Moves the player to the left (strafe left).
  *
- * This function calculates a new position by subtracting the player's camera plane scaled by MOVE_SPEED,
+ * This function calculates a new position by subtracting the player's camera plane scaled by MOVE_SPEED / SIM_HZ,
  * then verifies that the new position is not obstructed (empty space or open door) before updating the player's position.
  *
  * @param game Pointer to the t_game structure containing the player's position and map data.
@@ -133,18 +135,18 @@ void move_left(t_game *game)
 	double offset_x;
 	double offset_y;
 
-	new_x = game->player_x - game->plane_x * MOVE_SPEED;
-	new_y = game->player_y - game->plane_y * MOVE_SPEED;
+	new_x = game->player_x - game->plane_x * MOVE_SPEED / SIM_HZ;
+	new_y = game->player_y - game->plane_y * MOVE_SPEED / SIM_HZ;
 	offset_x = -0.2;
 	offset_y = -0.2;
 	if (game->plane_x < 0)
 		offset_x = 0.2;
 	if (game->plane_y < 0)
 		offset_y = 0.2;
-	if (game->world_map[(int)(game->player_y)][(int)(new_x + offset_x)] == 0
-		|| game->world_map[(int)(game->player_y)][(int)(new_x + offset_x)] == 3)
+	if (*map_cell(game, (int)(new_x + offset_x), (int)(game->player_y)) == 0
+		|| *map_cell(game, (int)(new_x + offset_x), (int)(game->player_y)) == 3)
 		game->player_x = new_x;
-	if (game->world_map[(int)(new_y + offset_y)][(int)(game->player_x)] == 0
-		|| game->world_map[(int)(new_y + offset_y)][(int)(game->player_x)] == 3)
+	if (*map_cell(game, (int)(game->player_x), (int)(new_y + offset_y)) == 0
+		|| *map_cell(game, (int)(game->player_x), (int)(new_y + offset_y)) == 3)
 		game->player_y = new_y;
 }
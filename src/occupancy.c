@@ -0,0 +1,97 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Tells whether a map cell stops rays (anything but empty floor and open doors).
+ *
+ * @param cell The cell value.
+ * @return int 1 if the cell is solid, 0 otherwise.
+ */
+static int cell_solid(uint8_t cell)
+{
+	return (cell != 0 && cell != 3);
+}
+
+/**
+ * @brief Builds the occupancy pyramid of the world grid.
+ *
+ * Every level counts the solid cells of each 8x8 (level 0) and 64x64 (level 1) block of the
+ * grid, sentinel border included. A block with a count of 0 holds no wall or closed door,
+ * so a ray can cross it in one jump (see perform_dda_skip()). Counts rather than bits let
+ * map_set() update a block when a single cell changes. Skipping is only enabled on maps
+ * larger than OCC_MIN_MAP in either dimension; on smaller maps the rays are short and the
+ * packet tracer is faster.
+ *
+ * @param game Pointer to the t_game structure holding the grid.
+ */
+void occupancy_build(t_game *game)
+{
+	int	level;
+	int	rows;
+	int	x;
+	int	y;
+
+	level = -1;
+	while (++level < OCC_LEVELS)
+	{
+		game->occ.stride[level] = ((game->map_width + 2)
+				>> (OCC_SHIFT * (level + 1))) + 1;
+		rows = ((game->map_height + 2) >> (OCC_SHIFT * (level + 1))) + 1;
+		game->occ.blocks[level] = ft_calloc((size_t)game->occ.stride[level] * rows,
+				sizeof(uint16_t));
+		if (!game->occ.blocks[level])
+			return (perror("malloc"), exit(ERROR));
+		y = -2;
+		while (++y <= game->map_height)
+		{
+			x = -2;
+			while (++x <= game->map_width)
+				*occ_block(game, level, x, y) += cell_solid(*map_cell(game, x, y));
+		}
+	}
+	game->occ.enabled = game->map_width > OCC_MIN_MAP
+		|| game->map_height > OCC_MIN_MAP;
+}
+
+/**
+ * @brief Frees the occupancy pyramid.
+ *
+ * @param game Pointer to the t_game structure holding the occupancy pyramid.
+ */
+void occupancy_free(t_game *game)
+{
+	int	level;
+
+	level = 0;
+	while (level < OCC_LEVELS)
+	{
+		free(game->occ.blocks[level]);
+		game->occ.blocks[level++] = NULL;
+	}
+}
+
+/**
+ * @brief Changes a map cell at run time and keeps the occupancy pyramid in sync.
+ *
+ * When the cell switches between solid and passable (a door closing or opening), the
+ * counters of the blocks holding it are adjusted, so the pyramid never needs a rebuild. Any change bumps
+ * the map generation, which makes the next frame redraw the scene (see damage_collect()).
+ * It must not be called while a frame is rendering.
+ *
+ * @param game Pointer to the t_game structure holding the grid.
+ * @param x Column of the cell.
+ * @param y Row of the cell.
+ * @param value The new cell value.
+ */
+void map_set(t_game *game, int x, int y, uint8_t value)
+{
+	int	delta;
+	int	level;
+
+	if (*map_cell(game, x, y) != value)
+		game->damage.map_gen++;
+	delta = cell_solid(value) - cell_solid(*map_cell(game, x, y));
+	*map_cell(game, x, y) = value;
+	level = 0;
+	while (delta && level < OCC_LEVELS)
+		*occ_block(game, level++, x, y) += delta;
+}
@@ -0,0 +1,115 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Starts timing a frame of render().
+ *
+ * The stage times of the new sample are cleared; the frame time runs until perf_end().
+ *
+ * @param game Pointer to the t_game structure holding the timers.
+ */
+void perf_begin(t_game *game)
+{
+	ft_memset(&game->perf.current, 0, sizeof(t_perf_sample));
+	game->perf.current.start = stage_clock();
+	game->perf.mark = game->perf.current.start;
+}
+
+/**
+ * @brief Marks the start of a timed stage.
+ *
+ * @param game Pointer to the t_game structure holding the timers.
+ */
+void perf_mark(t_game *game)
+{
+	game->perf.mark = stage_clock();
+}
+
+/**
+ * @brief Charges the time since the last perf_mark() to a stage of the current frame.
+ *
+ * A stage may be timed several times in one frame; its times add up.
+ *
+ * @param game Pointer to the t_game structure holding the timers.
+ * @param stage The stage to charge (see t_perf_stage).
+ */
+void perf_stage(t_game *game, int stage)
+{
+	unsigned long long	now;
+
+	now = stage_clock();
+	game->perf.current.stage_ms[stage] += (now - game->perf.mark) / 1e6;
+	game->perf.mark = now;
+}
+
+/**
+ * @brief Finishes the current frame and records it.
+ *
+ * The sample is written to the ring slot after the last one and only then published by
+ * advancing head with a release store, so a reader that loads head with acquire ordering sees
+ * complete samples without taking a lock (as long as it reads less than PERF_FRAMES behind).
+ * The frame time also goes into the histogram and the totals of the whole run, which
+ * perf_report() summarizes on exit. Recording a frame costs a handful of stores; with the
+ * overlay off, the timers add a few clock reads per frame and nothing else.
+ *
+ * @param game Pointer to the t_game structure holding the timers.
+ */
+void perf_end(t_game *game)
+{
+	t_perf			*perf;
+	unsigned long	head;
+	long			bucket;
+	int				i;
+
+	perf = &game->perf;
+	perf->current.frame_ms = (stage_clock() - perf->current.start) / 1e6;
+	head = atomic_load_explicit(&perf->head, memory_order_relaxed);
+	perf->ring[head % PERF_FRAMES] = perf->current;
+	atomic_store_explicit(&perf->head, head + 1, memory_order_release);
+	bucket = (long)(perf->current.frame_ms * 1000.0 / PERF_BUCKET_US);
+	if (bucket >= PERF_BUCKETS)
+		bucket = PERF_BUCKETS - 1;
+	perf->hist[bucket]++;
+	perf->count++;
+	perf->total_ms += perf->current.frame_ms;
+	i = -1;
+	while (++i < PERF_STAGES)
+		perf->stage_total[i] += perf->current.stage_ms[i];
+	if (perf->current.frame_ms > perf->max_ms)
+		perf->max_ms = perf->current.frame_ms;
+}
+
+/**
+ * @brief Shows or hides the performance overlay.
+ *
+ * The scene is marked as damaged either way, so the overlay appears right away and leaves no
+ * trace in the frame once hidden.
+ *
+ * @param game Pointer to the t_game structure holding the timers.
+ */
+void perf_toggle(t_game *game)
+{
+	game->perf.overlay = !game->perf.overlay;
+	game->damage.pending |= DAMAGE_SCENE;
+}
+
+/**
+ * @brief Records the time from the event loop waking up to the frame being presented.
+ *
+ * The loop sleeps while nothing changes (see damage_idle_us()); this is the latency an input
+ * event or a timer sees on top of drawing the frame. perf_report() prints its mean and maximum.
+ *
+ * @param game Pointer to the t_game structure holding the timers.
+ * @param woke When the loop woke up, from stage_clock()'s clock; 0 if it did not sleep.
+ */
+void perf_wake(t_game *game, unsigned long long woke)
+{
+	double	ms;
+
+	if (!woke)
+		return ;
+	ms = (stage_clock() - woke) / 1e6;
+	game->perf.wakes++;
+	game->perf.wake_total_ms += ms;
+	if (ms > game->perf.wake_max_ms)
+		game->perf.wake_max_ms = ms;
+}
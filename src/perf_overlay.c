@@ -0,0 +1,169 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Finds the top-left corner of the overlay box.
+ *
+ * The box sits in the top-right corner, clear of the minimap, and is PERF_FRAMES bars wide;
+ * PERF_LINES lines of text go above the frame-time graph.
+ *
+ * @param game Pointer to the t_game structure holding the output frame.
+ * @param pos Array receiving the x and y of the corner.
+ * @return int OK if the overlay fits, ERROR otherwise.
+ */
+static int overlay_corner(t_game *game, int *pos)
+{
+	pos[0] = game->output.width - PERF_FRAMES * PERF_BAR_W - PERF_MARGIN;
+	pos[1] = PERF_MARGIN;
+	if (pos[0] < PERF_MARGIN || game->output.height < PERF_MARGIN * 2
+		+ PERF_LINES * PERF_LINE_H + PERF_GRAPH_H)
+		return (ERROR);
+	return (OK);
+}
+
+/**
+ * @brief Draws one stacked bar of the frame-time graph.
+ *
+ * Each stage gets a segment in its own color, stacked from the bottom, and the rest of the
+ * frame (damage tracking, the overlay itself) is grey. PERF_GRAPH_MS fills the whole graph
+ * height; longer frames are clipped.
+ *
+ * @param game Pointer to the t_game structure holding the output frame.
+ * @param s The frame to draw.
+ * @param x Left column of the bar.
+ * @param bottom Bottom row of the graph.
+ */
+static void overlay_bar(t_game *game, t_perf_sample *s, int x, int bottom)
+{
+	static const unsigned int	colors[PERF_STAGES + 1] = {0x40C040, 0x4080FF,
+		0xE0C040, 0xE04040, 0x808080};
+	double						ms[PERF_STAGES + 1];
+	int							i;
+	int							y;
+	int							h;
+
+	ms[PERF_STAGES] = s->frame_ms;
+	i = -1;
+	while (++i < PERF_STAGES)
+	{
+		ms[i] = s->stage_ms[i];
+		ms[PERF_STAGES] -= ms[i];
+	}
+	y = bottom;
+	i = -1;
+	while (++i <= PERF_STAGES && y > bottom - PERF_GRAPH_H)
+	{
+		h = (int)(ms[i] * PERF_GRAPH_H / PERF_GRAPH_MS + 0.5);
+		while (h-- > 0 && y > bottom - PERF_GRAPH_H)
+		{
+			game->output.pixels[(size_t)y * game->output.pitch + x] = colors[i];
+			if (PERF_BAR_W > 1)
+				game->output.pixels[(size_t)y * game->output.pitch + x + 1]
+					= colors[i];
+			y--;
+		}
+	}
+}
+
+/**
+ * @brief Draws the performance overlay into the output frame.
+ *
+ * The box is darkened and filled with a graph of the last PERF_FRAMES frames, oldest on the
+ * left, one stacked bar per frame with the move, scene, minimap and present stages in green,
+ * blue, yellow and red. The dotted line marks 60 FPS. The text above the graph is written
+ * by perf_overlay_text() once the frame is on screen. It is called after the scene is drawn
+ * and before it is presented; while the overlay is shown every frame is drawn anew.
+ *
+ * @param game Pointer to the t_game structure holding the timers and the output frame.
+ */
+void perf_overlay_draw(t_game *game)
+{
+	unsigned int	*px;
+	unsigned long	head;
+	int				pos[2];
+	int				x;
+	int				y;
+
+	if (overlay_corner(game, pos) == ERROR)
+		return ;
+	y = pos[1] - 1;
+	while (++y < pos[1] + PERF_LINES * PERF_LINE_H + PERF_GRAPH_H)
+	{
+		px = game->output.pixels + (size_t)y * game->output.pitch + pos[0];
+		x = -1;
+		while (++x < PERF_FRAMES * PERF_BAR_W)
+			px[x] = (px[x] >> 1) & 0x7F7F7F;
+	}
+	head = atomic_load_explicit(&game->perf.head, memory_order_acquire);
+	x = -1;
+	while (++x < PERF_FRAMES)
+		if (head + x >= PERF_FRAMES)
+			overlay_bar(game, &game->perf.ring[(head + x) % PERF_FRAMES],
+				pos[0] + x * PERF_BAR_W, y - 1);
+	y = y - 1 - (int)(1000.0 / 60.0 * PERF_GRAPH_H / PERF_GRAPH_MS);
+	x = -2;
+	while ((x += 2) < PERF_FRAMES * PERF_BAR_W)
+		game->output.pixels[(size_t)y * game->output.pitch + pos[0] + x] = 0xC0C0C0;
+}
+
+/**
+ * @brief Averages the frames in the ring: FPS, frame time and stage times.
+ *
+ * @param perf Pointer to the t_perf structure holding the ring.
+ * @param avg Array receiving the mean stage times, then the mean frame time, in ms.
+ * @return double Frames per second over the ring, or 0 with fewer than two frames.
+ */
+static double overlay_average(t_perf *perf, double *avg)
+{
+	unsigned long	head;
+	unsigned long	n;
+	unsigned long	i;
+	int				s;
+
+	head = atomic_load_explicit(&perf->head, memory_order_acquire);
+	n = head;
+	if (n > PERF_FRAMES)
+		n = PERF_FRAMES;
+	ft_memset(avg, 0, (PERF_STAGES + 1) * sizeof(double));
+	i = head - n - 1;
+	while (++i < head)
+	{
+		s = -1;
+		while (++s < PERF_STAGES)
+			avg[s] += perf->ring[i % PERF_FRAMES].stage_ms[s] / n;
+		avg[PERF_STAGES] += perf->ring[i % PERF_FRAMES].frame_ms / n;
+	}
+	if (n < 2 || perf->ring[(head - 1) % PERF_FRAMES].start
+		== perf->ring[(head - n) % PERF_FRAMES].start)
+		return (0.0);
+	return ((n - 1) * 1e9 / (perf->ring[(head - 1) % PERF_FRAMES].start
+		- perf->ring[(head - n) % PERF_FRAMES].start));
+}
+
+/**
+ * @brief Writes the FPS, the mean frame and stage times and the present path over the graph.
+ *
+ * MLX draws text straight to the window, so this runs after the frame has been put on it.
+ *
+ * @param game Pointer to the t_game structure holding the timers and the MLX window.
+ */
+void perf_overlay_text(t_game *game)
+{
+	char	line[PERF_LINES][64];
+	double	avg[PERF_STAGES + 1];
+	double	fps;
+	int		pos[2];
+	int		i;
+
+	if (overlay_corner(game, pos) == ERROR)
+		return ;
+	fps = overlay_average(&game->perf, avg);
+	snprintf(line[0], 64, "FPS %.0f   frame %.2f ms", fps, avg[PERF_STAGES]);
+	snprintf(line[1], 64, "move %.2f   scene %.2f", avg[PERF_MOVE],
+		avg[PERF_SCENE]);
+	snprintf(line[2], 64, "minimap %.2f   present %.2f %s", avg[PERF_MINIMAP],
+		avg[PERF_PRESENT], game->present_mode);
+	i = -1;
+	while (++i < PERF_LINES)
+		mlx_string_put(game->mlx, game->win, pos[0] + 4,
+			pos[1] + (i + 1) * PERF_LINE_H - 3, 0xFFFFFF, line[i]);
+}
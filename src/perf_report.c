@@ -0,0 +1,67 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Returns a percentile of the frame times of the whole run.
+ *
+ * The histogram has PERF_BUCKET_US wide buckets, so the result is the upper edge of the
+ * bucket holding the nearest-rank percentile, capped by the slowest frame.
+ *
+ * @param perf Pointer to the t_perf structure holding the histogram.
+ * @param q The percentile, in (0, 1].
+ * @return double The frame time in milliseconds.
+ */
+static double perf_percentile(t_perf *perf, double q)
+{
+	unsigned long	rank;
+	unsigned long	seen;
+	int				i;
+
+	rank = (unsigned long)ceil(q * perf->count);
+	seen = 0;
+	i = -1;
+	while (++i < PERF_BUCKETS - 1)
+	{
+		seen += perf->hist[i];
+		if (seen >= rank)
+			break ;
+	}
+	if ((i + 1) * PERF_BUCKET_US / 1000.0 < perf->max_ms)
+		return ((i + 1) * PERF_BUCKET_US / 1000.0);
+	return (perf->max_ms);
+}
+
+/**
+ * @brief Prints a summary of the frame times of the whole run to stderr.
+ *
+ * It gives the number of frames drawn, the mean frame time and FPS, the p50, p90 and p99
+ * frame times and the slowest frame, the mean time of each stage timed in render() and, with a
+ * window, the path MLX presents frames through (see mlx_present_mode()) and the time from the
+ * event loop waking up to the frame being presented (see perf_wake()). Only frames that
+ * drew or presented something count; skipped idle frames do not.
+ *
+ * @param game Pointer to the t_game structure holding the timers.
+ */
+void perf_report(t_game *game)
+{
+	t_perf	*perf;
+
+	perf = &game->perf;
+	if (!perf->count)
+		return ;
+	fprintf(stderr, "frames: %lu, mean %.2f ms (%.1f FPS)\n", perf->count,
+		perf->total_ms / perf->count, 1000.0 * perf->count / perf->total_ms);
+	fprintf(stderr, "frame time: p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, "
+		"max %.2f ms\n", perf_percentile(perf, 0.50),
+		perf_percentile(perf, 0.90), perf_percentile(perf, 0.99),
+		perf->max_ms);
+	fprintf(stderr, "stages (mean): move %.3f ms, scene %.3f ms, minimap %.3f ms, "
+		"present %.3f ms\n", perf->stage_total[PERF_MOVE] / perf->count,
+		perf->stage_total[PERF_SCENE] / perf->count,
+		perf->stage_total[PERF_MINIMAP] / perf->count,
+		perf->stage_total[PERF_PRESENT] / perf->count);
+	if (game->present_mode)
+		fprintf(stderr, "present path: %s\n", game->present_mode);
+	if (perf->wakes)
+		fprintf(stderr, "wake to present: mean %.3f ms, max %.3f ms (%lu wakeups)\n",
+			perf->wake_total_ms / perf->wakes, perf->wake_max_ms, perf->wakes);
+}
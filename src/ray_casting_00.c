@@ -1,98 +1,185 @@
 #include "../include/cub3d.h"
 
 /**
- * @brief Puts a pixel of a given color onto the image, if within bounds.
+ * @brief Renders one tile of RENDER_TILE adjacent screen columns.
  *
- * This function calculates the address for the pixel at (x, y) in the image buffer and sets its color.
- * It ensures that the pixel coordinates are within the defined WIDTH and HEIGHT limits.
+ * This function is the task run by the worker pool. The columns of the tile are handled in
+ * packets of RAY_PACKET rays: for each ray it calculates the direction and initializes the
+ * position and steps, traces the whole packet with trace_rays(), draws the wall of every
+ * column into the column-major frame buffer and then fills the flat ceiling and floor above
+ * and below it. The finished tile is transposed into the render target, and the farthest wall
+ * distance of its columns is kept in game->zbuf_tile so render_sprites() can cull sprites
+ * hidden behind the whole tile. Every tile only writes its own pixels, so tiles can be
+ * rendered concurrently. Benchmark builds (BENCH) charge the ray setup, the DDA, the walls and
+ * the flat ceiling and floor of every packet, and the transpose of the tile, to their own
+ * stage timers.
  *
- * @param img Pointer to the image structure containing image data and parameters.
- * @param x The x-coordinate of the pixel.
- * @param y The y-coordinate of the pixel.
- * @param color The color to set the pixel (in hexadecimal).
+ * @param ctx Pointer to the t_game structure containing game-specific parameters for rendering.
+ * @param tile Index of the tile to render.
  */
-static void put_pixel_clear(t_img *img, int x, int y, int color)
+static void render_tile(void *ctx, int tile)
 {
-	char *dst;
+	t_game		*game;
+	t_ray_cast			rc[RAY_PACKET];
+	unsigned long long	t;
+	int					x;
+	int					end;
+	int					i;
 
-	if (x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT)
+	game = (t_game *)ctx;
+	t = 0;
+	if (BENCH)
+		t = stage_clock();
+	x = tile * RENDER_TILE;
+	end = x + RENDER_TILE;
+	if (end > game->render_w)
+		end = game->render_w;
+	while (x < end)
 	{
-		dst = img->addr + (y * img->line_length + x * (img->bpp / 8));
-		*(unsigned int *)dst = color;
+		i = -1;
+		while (++i < RAY_PACKET && x + i < end)
+		{
+			rc[i].x = x + i;
+			calculate_ray_direction(game, &rc[i]);
+			initialize_ray_position(game, &rc[i]);
+			initialize_step_and_sidedist(game, &rc[i]);
+			rc[i].hit = 0;
+		}
+		if (BENCH)
+			t = stage_add(game, STAGE_SETUP, t);
+		trace_rays(game, rc, i);
+		if (BENCH)
+			t = stage_add(game, STAGE_DDA, t);
+		while (--i >= 0)
+			render_column(game, &rc[i]);
+		if (BENCH)
+			t = stage_add(game, STAGE_WALLS, t);
+		i = x - 1;
+		while (++i < x + RAY_PACKET && i < end)
+			draw_ceiling_and_floor(game, i);
+		if (BENCH)
+			t = stage_add(game, STAGE_BACKGROUND, t);
+		x += RAY_PACKET;
 	}
+	transpose_columns(game, tile * RENDER_TILE, end);
+	game->zbuf_tile[tile] = 0;
+	x = tile * RENDER_TILE - 1;
+	while (++x < end)
+		if (game->zbuf[x] > game->zbuf_tile[tile])
+			game->zbuf_tile[tile] = game->zbuf[x];
+	if (BENCH)
+		stage_add(game, STAGE_TRANSPOSE, t);
 }
 
 /**
- * @brief Clears the entire image by filling it with black.
+ * @brief Renders the 3D scene using raycasting.
  *
- * This function iterates over every pixel in the image and sets its color to 0x000000 (black),
- * effectively clearing any previous rendering.
+ * This function splits the render target into tiles of RENDER_TILE columns and hands them to
+ * the worker pool, which renders them in parallel and returns once the whole frame is drawn.
+ * A textured floor or ceiling is then cast row by row over it (see render_floor()), and the
+ * sprites are drawn on top (see render_sprites()). When the render scale is below 1 the frame
+ * is then upscaled into the output frame. Nothing is presented: render() and render_frame()
+ * call this with a window or a caller-provided frame as output. Benchmark builds (BENCH) time
+ * every pass on this thread; the tile pass is then split by the worker timers of render_tile().
  *
- * @param img Pointer to the image structure to be cleared.
+ * @param game Pointer to the t_game structure containing game-specific parameters for rendering.
  */
-static void clear_image(t_img *img)
+void render_scene(t_game *game)
 {
-	int x;
-	int y;
+	unsigned long long	t;
 
-	y = 0;
-	while (y < HEIGHT)
-	{
-		x = 0;
-		while (x < WIDTH)
-		{
-			put_pixel_clear(img, x, y, 0x000000);
-			x++;
-		}
-		y++;
-	}
+	t = 0;
+	if (BENCH)
+		t = stage_clock();
+	pool_run(&game->pool, render_tile, game,
+		(game->render_w + RENDER_TILE - 1) / RENDER_TILE);
+	if (BENCH)
+		t = stage_add(game, STAGE_TILES, t);
+	render_floor(game);
+	if (BENCH)
+		t = stage_add(game, STAGE_FLOOR, t);
+	render_sprites(game);
+	if (BENCH)
+		t = stage_add(game, STAGE_SPRITES, t);
+	render_upscale(game);
+	if (BENCH)
+		stage_add(game, STAGE_UPSCALE, t);
 }
 
 /**
- * @brief Renders the 3D scene using raycasting.
+ * @brief Draws a new scene into the next output frame.
  *
- * This function iterates over each vertical stripe (pixel column) of the window and performs
- * raycasting to determine what should be rendered at that column. It calculates the ray direction,
- * initializes ray positions and steps, and processes ray casting for each column.
+ * The backend first switches the output frame to a buffer the display is done with (see the
+ * acquire function of t_backend); any wait for it counts as presentation time. The scene is
+ * timed for the performance overlay, which is drawn on top when it is shown.
+ * The frame is not cleared first: every column writes its wall span and the rows of a flat
+ * colored ceiling or floor, every tile is transposed in full, and render_floor() fills the
+ * rows of a textured ceiling or floor the columns left out, so the whole frame is always
+ * covered. Debug builds verify this with coverage_poison() and coverage_check().
  *
- * @param vars Pointer to the t_vars structure containing overall game data.
  * @param game Pointer to the t_game structure containing game-specific parameters for rendering.
  */
-static void render_scene(t_vars *vars, t_game *game)
+static void draw_frame(t_game *game)
 {
-	t_ray_cast rc;
-
-	rc.x = 0;
-	while (rc.x < WIDTH)
-	{
-		calculate_ray_direction(game, &rc);
-		initialize_ray_position(game, &rc);
-		initialize_step_and_sidedist(game, &rc);
-		rc.hit = 0;
-		process_ray_casting(game, vars, &rc);
-		rc.x++;
-	}
+	perf_mark(game);
+	game->backend->acquire(game);
+	perf_stage(game, PERF_PRESENT);
+	if (DEBUG)
+		coverage_poison(game);
+	perf_mark(game);
+	render_scene(game);
+	perf_stage(game, PERF_SCENE);
+	if (DEBUG)
+		coverage_check(game);
+	if (game->perf.overlay)
+		perf_overlay_draw(game);
 }
 
 /**
  * @brief Main render loop function.
  *
- * This function clears the image, updates player movement, renders the 3D scene via raycasting,
- * and then displays the final image to the window. In BONUS mode, it also draws a minimap.
- * Additionally, it manages the door cooldown timer.
+ * This function runs the simulation ticks that are due (see sim_advance()), places the camera
+ * between the last two simulated states (see sim_interpolate()), resolves the door animation
+ * frame (see door_anim_update()) and asks damage_collect() what changed since the last frame.
+ * Only a damaged scene is raycast, and the backend is only asked to present when a new
+ * scene was drawn, the window was exposed, or (BONUS) the minimap was covered or the player
+ * entered another cell; when nothing changed the frame is skipped and the backend is told how
+ * long it may sleep: until the next input event or the next frame the clock calls for (see
+ * damage_idle_us()).
+ * Once the frame is presented the player is put back at the simulated state. Frames that
+ * draw or present anything are timed stage by stage for the performance overlay and the
+ * exit report (see perf_end()), and rendered frames for the dynamic resolution controller
+ * (see dynres_end()). While the overlay is shown the scene is redrawn every frame, so the
+ * graph stays live.
  *
  * @param vars Pointer to the t_vars structure containing all game-related data.
  * @return int Always returns 0.
  */
 int render(t_vars *vars)
 {
-	clear_image(&vars->game->img);
-	update_movement(vars->game);
-	render_scene(vars, vars->game);
-	mlx_put_image_to_window(vars->game->mlx, vars->game->win, vars->game->img.img, 0, 0);
-	if (BONUS)
-		draw_minimap(vars->game);
-	if (vars->game->door_cooldown > 0)
-		vars->game->door_cooldown--;
+	t_game	*game;
+	double	alpha;
+	int		damage;
+
+	game = vars->game;
+	dynres_begin(game);
+	perf_begin(game);
+	alpha = sim_advance(game);
+	perf_stage(game, PERF_MOVE);
+	sim_interpolate(game, alpha);
+	door_anim_update(game);
+	if (game->perf.overlay)
+		game->damage.pending |= DAMAGE_SCENE;
+	damage = damage_collect(game);
+	if (damage & DAMAGE_SCENE)
+		draw_frame(game);
+	if (damage & (DAMAGE_PRESENT | DAMAGE_MINIMAP))
+		game->backend->present(game, damage);
+	camera_set(game, &game->sim.curr);
+	if (damage)
+		perf_end(game);
+	if (damage & DAMAGE_SCENE)
+		dynres_end(game);
+	game->backend->idle(game, damage_idle_us(game, damage));
 	return (0);
 }
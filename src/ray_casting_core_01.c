@@ -1,63 +1,57 @@
 #include "../include/cub3d.h"
 
-/**
- * @brief Selects the appropriate door texture based on the animation counter.
- *
- * This function assigns a door texture from the game textures array based on the value of the counter `i`.
- * The textures are selected in 10,000 increments, cycling through DOOR1, DOOR2, DOOR3, and DOOR4.
- *
- * @param game Pointer to the t_game structure containing textures.
- * @param i The current animation counter value.
- * @param texture Pointer to a t_img structure where the selected texture will be stored.
- */
-static void select_door_tex(t_game *game, int i, t_img *texture)
-{
-	if (i <= 10000)
-		*texture = game->textures[DOOR1];
-	else if (i <= 20000)
-		*texture = game->textures[DOOR2];
-	else if (i <= 30000)
-		*texture = game->textures[DOOR3];
-	else if (i <= 40000)
-		*texture = game->textures[DOOR4];
-}
-
 /**
  * @brief Selects the correct wall or door texture for the current ray.
  *
  * This function determines which texture to use based on the map cell value and the side of the wall hit.
- * If the cell corresponds to a door (value 2), it selects a door texture based on a static counter.
- * Otherwise, it selects a wall texture based on the ray's direction.
+ * If the cell corresponds to a door (value 2), it looks up the texture of the door's animation
+ * phase, which door_anim_update() resolved for the whole frame (the phase comes from the cell
+ * coordinates, so neighbouring doors are out of step), and
+ * flags the frame as showing an animated door. Otherwise, it selects a wall texture based on the ray's direction.
  *
- * @param game Pointer to the t_game structure containing textures and map data.
+ * @param game Pointer to the t_game structure containing the map data.
  * @param rc Pointer to the t_ray_cast structure containing raycasting data.
- * @param texture Pointer to a t_img structure where the selected texture will be stored.
+ * @return int The texture id, i.e. the index into game->tex.
  */
-static void select_texture(t_game *game, t_ray_cast *rc, t_img *texture)
+static int select_texture(t_game *game, t_ray_cast *rc)
 {
-	static int i;
-
-	if (game->world_map[rc->map_y][rc->map_x] == 2)
+	if (*map_cell(game, rc->map_x, rc->map_y) == 2)
 	{
-		if (i >= 40000)
-			i = 0;
-		select_door_tex(game, i, texture);
+		atomic_store_explicit(&game->damage.doors_seen, 1, memory_order_relaxed);
+		return (game->anim.door_tex[(unsigned int)(rc->map_x + rc->map_y * 2)
+			% DOOR_FRAMES]);
 	}
 	else if (rc->side == 1)
 	{
 		if (rc->ray_dir_y < 0)
-			*texture = game->textures[NORTH];
-		else
-			*texture = game->textures[SOUTH];
+			return (NORTH);
+		return (SOUTH);
 	}
-	else
-	{
-		if (rc->ray_dir_x < 0)
-			*texture = game->textures[WEST];
-		else
-			*texture = game->textures[EAST];
-	}
-	i++;
+	if (rc->ray_dir_x < 0)
+		return (WEST);
+	return (EAST);
+}
+
+/**
+ * @brief Selects the mip level of a texture to draw a wall slice with.
+ *
+ * The smallest level that is still at least as tall as the wall slice on screen is used,
+ * so each screen pixel steps over one to two texels of it: close walls keep the full
+ * texture, while distant walls read a small level instead of skipping across the big one.
+ *
+ * @param texture Pointer to the selected texture.
+ * @param line_height Height of the wall slice in pixels.
+ * @return t_mip* Pointer to the chosen mip level.
+ */
+static t_mip *select_mip(t_texture *texture, int line_height)
+{
+	int	level;
+
+	level = 0;
+	while (level + 1 < texture->mip_count
+		&& texture->mips[level + 1].height >= line_height)
+		level++;
+	return (&texture->mips[level]);
 }
 
 /**
@@ -95,9 +89,11 @@ static double calculate_perp_wall_dist(t_game *game, t_ray_cast *rc)
 /**
  * @brief Calculates wall rendering parameters for the current ray.
  *
- * This function computes the perpendicular wall distance, determines the height of the wall line,
- * and calculates the start and end positions on the screen where the wall should be drawn.
- * It also determines the texture number based on the map cell value.
+ * This function computes the perpendicular wall distance (bounded below by MIN_WALL_DIST so the
+ * line height always fits in an int), determines the height of the wall line,
+ * and calculates the start and end positions in the render target where the wall should be drawn.
+ * It also determines the texture number based on the map cell value and resolves the fog level
+ * of the column once, so the wall span only has to apply the precomputed scale.
  *
  * @param game Pointer to the t_game structure containing the player's position and map data.
  * @param rc Pointer to the t_ray_cast structure containing current ray data.
@@ -105,35 +101,46 @@ static double calculate_perp_wall_dist(t_game *game, t_ray_cast *rc)
  */
 static void calculate_wall_params(t_game *game, t_ray_cast *rc, t_ray_cast_draw *rcw)
 {
+	int	level;
+
 	rcw->perp_wall_dist = calculate_perp_wall_dist(game, rc);
-	rcw->line_height = (int)(HEIGHT / rcw->perp_wall_dist);
-	rcw->draw_start = (HEIGHT - rcw->line_height) / 2;
-	rcw->draw_end = (HEIGHT + rcw->line_height) / 2;
+	if (rcw->perp_wall_dist < MIN_WALL_DIST)
+		rcw->perp_wall_dist = MIN_WALL_DIST;
+	rcw->line_height = (int)(game->render_h / rcw->perp_wall_dist);
+	rcw->draw_start = (game->render_h - rcw->line_height) / 2;
+	rcw->draw_end = (game->render_h + rcw->line_height) / 2;
 	if (rcw->draw_start < 0)
 		rcw->draw_start = 0;
-	if (rcw->draw_end >= HEIGHT)
-		rcw->draw_end = HEIGHT - 1;
-	rcw->tex_num = game->world_map[rc->map_y][rc->map_x] - 1;
+	if (rcw->draw_end >= game->render_h)
+		rcw->draw_end = game->render_h - 1;
+	rcw->tex_num = *map_cell(game, rc->map_x, rc->map_y) - 1;
+	level = fog_level(&game->fog, rcw->perp_wall_dist);
+	rcw->fog_scale = game->fog.scale[level];
+	rcw->fog_add = game->fog.add[level];
 }
 
 /**
  * @brief Renders a single vertical column (stripe) of the 3D scene.
  *
- * This function calculates the necessary wall parameters, selects the appropriate texture,
- * computes texture coordinates, and then draws the wall column. It also draws the ceiling and floor.
+ * This function calculates the necessary wall parameters, selects the appropriate texture and
+ * its mip level, computes texture coordinates, and then draws the wall column into the
+ * column's contiguous slice of the column-major frame buffer. The rows the wall covers are
+ * recorded in game->spans for draw_ceiling_and_floor() and the floor caster, and the wall
+ * distance in game->zbuf for the sprites.
  *
  * @param game Pointer to the t_game structure containing rendering and map data.
- * @param vars Pointer to the t_vars structure containing overall game data.
  * @param rc Pointer to the t_ray_cast structure with current raycasting information.
  */
-void render_column(t_game *game, t_vars *vars, t_ray_cast *rc)
+void render_column(t_game *game, t_ray_cast *rc)
 {
 	t_ray_cast_draw rcw;
-	t_img texture;
+	t_mip *mip;
 
+	rcw.column = game->colbuf + (size_t)rc->x * game->render_h;
 	calculate_wall_params(game, rc, &rcw);
-	select_texture(game, rc, &texture);
-	calculate_texture_coordinates(game, rc, &rcw, &texture);
-	draw_wall_column(game, rc, &rcw, &texture);
-	draw_ceiling_and_floor(rc, &rcw, vars);
+	mip = select_mip(&game->tex[select_texture(game, rc)], rcw.line_height);
+	calculate_texture_coordinates(game, rc, &rcw, mip);
+	draw_wall_column(&rcw, mip, game->render_h);
+	game->spans[rc->x] = (t_span){rcw.draw_start, rcw.draw_end};
+	game->zbuf[rc->x] = rcw.perp_wall_dist;
 }
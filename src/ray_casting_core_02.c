@@ -3,68 +3,62 @@
 /**
  * @brief Draws the ceiling and floor with a fog effect.
  *
- * This function draws the ceiling from the top of the screen to the start of the wall,
- * and the floor from the end of the wall to the bottom of the screen. It calculates a
- * current distance factor for each pixel row and applies a fog effect through the functions
- * put_pixel_fog_ceiling() and put_pixel_fog_floor().
+ * This function copies the ceiling from the top of the screen to the start of the wall,
+ * and the floor from the end of the wall to the bottom of the screen, out of the prebuilt
+ * fogged background (see background_build()). Both parts are plain memory copies into the
+ * column, so no distance or fog needs to be computed per pixel and the wall span is never
+ * written twice. It runs once render_column() has recorded the wall span of the column in
+ * game->spans, so benchmark builds can time it apart from the walls. A textured floor or
+ * ceiling is skipped here: render_floor() draws it over the whole frame once the columns
+ * are done.
  *
- * @param rc Pointer to the t_ray_cast structure containing the current column (x) of the screen.
- * @param rcw Pointer to the t_ray_cast_draw structure containing drawing parameters (draw_start and draw_end).
- * @param vars Pointer to the t_vars structure containing overall game data.
+ * @param game Pointer to the t_game structure holding the background and the wall spans.
+ * @param x The column of the frame buffer to draw into.
  */
-void draw_ceiling_and_floor(t_ray_cast *rc, t_ray_cast_draw *rcw, t_vars *vars)
+void draw_ceiling_and_floor(t_game *game, int x)
 {
-	int		x;
-	double	current_dist;
+	unsigned int	*column;
+	t_span			span;
 
-	x = rc->x;
-	rcw->y = 0;
-	while (rcw->y < rcw->draw_start)
-	{
-		current_dist = 1.0;
-		if (HEIGHT - 2 * rcw->y != 0)
-			current_dist = HEIGHT / (double)(HEIGHT - 2 * rcw->y);
-		put_pixel_fog_ceiling(vars, x, rcw->y, current_dist);
-		rcw->y++;
-	}
-	rcw->y = rcw->draw_end;
-	while (rcw->y < HEIGHT)
-	{
-		current_dist = 1.0;
-		if (2 * rcw->y - HEIGHT != 0)
-			current_dist = HEIGHT / (double)(2 * rcw->y - HEIGHT);
-		put_pixel_fog_floor(vars, x, rcw->y, current_dist);
-		rcw->y++;
-	}
+	column = game->colbuf + (size_t)x * game->render_h;
+	span = game->spans[x];
+	if (!game->tex[CEILING].mip_count)
+		memcpy(column, game->background, span.top * sizeof(unsigned int));
+	if (!game->tex[FLOOR].mip_count)
+		memcpy(column + span.bottom, game->background + span.bottom,
+			(game->render_h - span.bottom) * sizeof(unsigned int));
 }
 
 /**
  * @brief Draws a vertical wall column with texture mapping and fog effect.
  *
- * This function iterates from the start to the end of the wall column (draw_start to draw_end)
- * and computes the corresponding texture coordinate (tex_y) for each pixel. It then retrieves the
- * color from the texture and applies a fog effect via put_pixel_fog_walls() before drawing the pixel.
+ * This function walks the texture column with a 16.16 fixed-point position that advances by a
+ * constant step per screen row, so no division is needed per pixel. The texture is read from its
+ * column-major copy, so the whole slice comes from contiguous memory. The starting position is
+ * computed exactly in 64-bit arithmetic, which keeps it correct when line_height is huge because
+ * the player stands right next to a wall, and since the step is rounded down the position never
+ * leaves the texture. The span is shaded and written by put_span_fog_walls().
  *
- * @param game Pointer to the t_game structure containing game data and the image buffer.
- * @param rc Pointer to the t_ray_cast structure containing the current column (x) and ray data.
  * @param rcw Pointer to the t_ray_cast_draw structure with wall rendering parameters.
- * @param texture Pointer to the t_img structure containing the texture data.
+ * @param mip Pointer to the mip level of the texture to sample.
+ * @param height Height of the render target in pixels.
  */
-void draw_wall_column(t_game *game, t_ray_cast *rc, t_ray_cast_draw *rcw, t_img *texture)
+void draw_wall_column(t_ray_cast_draw *rcw, t_mip *mip, int height)
 {
-	rcw->y = rcw->draw_start;
-	while (rcw->y < rcw->draw_end)
-	{
-		rcw->d = rcw->y * 256 - HEIGHT * 128 + rcw->line_height * 128;
-		rcw->tex_y = ((rcw->d * texture->height) / rcw->line_height) / 256;
-		if (rcw->tex_y < 0)
-			rcw->tex_y = 0;
-		else if (rcw->tex_y >= texture->height)
-			rcw->tex_y = texture->height - 1;
-		rcw->color = *(unsigned int *)(texture->addr + (rcw->tex_y * texture->line_length + rcw->tex_x * (texture->bpp / 8)));
-		put_pixel_fog_walls(&game->img, rc->x, rcw);
-		rcw->y++;
-	}
+	unsigned int	*src;
+	long long		start;
+	unsigned int	pos;
+	unsigned int	step;
+
+	if (rcw->draw_start >= rcw->draw_end)
+		return ;
+	src = mip->columns + (size_t)rcw->tex_x * mip->height;
+	step = ((unsigned long long)mip->height << 16) / rcw->line_height;
+	start = 2LL * rcw->draw_start - height + rcw->line_height;
+	if (start < 0)
+		start = 0;
+	pos = ((start * mip->height) << 15) / rcw->line_height;
+	put_span_fog_walls(rcw, src, pos, step);
 }
 
 /**
@@ -77,16 +71,16 @@ void draw_wall_column(t_game *game, t_ray_cast *rc, t_ray_cast_draw *rcw, t_img
  * @param game Pointer to the t_game structure containing the player's position.
  * @param rc Pointer to the t_ray_cast structure containing the current ray information.
  * @param rcw Pointer to the t_ray_cast_draw structure where calculated drawing parameters will be stored.
- * @param texture Pointer to the t_img structure containing the texture data.
+ * @param mip Pointer to the mip level of the texture that will be sampled.
  */
-void calculate_texture_coordinates(t_game *game, t_ray_cast *rc, t_ray_cast_draw *rcw, t_img *texture)
+void calculate_texture_coordinates(t_game *game, t_ray_cast *rc, t_ray_cast_draw *rcw, t_mip *mip)
 {
 	if (rc->side == 0)
 		rcw->wall_x = game->player_y + rcw->perp_wall_dist * rc->ray_dir_y;
 	else
 		rcw->wall_x = game->player_x + rcw->perp_wall_dist * rc->ray_dir_x;
 	rcw->wall_x -= floor(rcw->wall_x);
-	rcw->tex_x = (int)(rcw->wall_x * (double)(texture->width));
+	rcw->tex_x = (int)(rcw->wall_x * (double)(mip->width));
 	if ((rc->side == 0 && rc->ray_dir_x > 0) || (rc->side == 1 && rc->ray_dir_y < 0))
-		rcw->tex_x = texture->width - rcw->tex_x - 1;
+		rcw->tex_x = mip->width - rcw->tex_x - 1;
 }
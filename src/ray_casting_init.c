@@ -5,13 +5,17 @@
  *
  * This function advances the ray step-by-step until it hits a wall. It compares side distances 
  * and increments the appropriate distance and map coordinate based on the smallest value.
- * The process stops when the ray hits a cell that is not empty (i.e., not 0 or 3).
+ * The process stops when the ray hits a cell that is not empty (i.e., not 0 or 3). The wall
+ * border around the grid guarantees a hit before the ray can leave it, so no bounds check
+ * is needed.
  *
  * @param game Pointer to the t_game structure containing the world map and player data.
  * @param rc Pointer to the t_ray_cast structure containing current raycasting data.
  */
-static void perform_dda(t_game *game, t_ray_cast *rc)
+void perform_dda(t_game *game, t_ray_cast *rc)
 {
+	int	cell;
+
 	while (!(rc->hit))
 	{
 		if (rc->side_dist_x < rc->side_dist_y)
@@ -26,26 +30,39 @@ static void perform_dda(t_game *game, t_ray_cast *rc)
 			rc->map_y += rc->step_y;
 			rc->side = 1;
 		}
-		if (game->world_map[rc->map_y][rc->map_x] != 0 &&
-			game->world_map[rc->map_y][rc->map_x] != 3)
+		cell = *map_cell(game, rc->map_x, rc->map_y);
+		if (cell != 0 && cell != 3)
 			rc->hit = 1;
 	}
 }
 
 /**
- * @brief Processes raycasting for a single column.
+ * @brief Traces a group of adjacent rays until each of them hits a wall.
  *
- * This function performs the DDA algorithm to determine where a ray hits a wall, and then calls
- * render_column() to draw the vertical slice (column) corresponding to that ray.
+ * On large maps (see occupancy_build()) every ray is traced with perform_dda_skip(), which
+ * jumps across empty blocks. Otherwise a full group of RAY_PACKET rays is traced together by
+ * perform_dda_packet(), and a shorter group (at the right edge of the frame) falls back to
+ * perform_dda() one ray at a time; those two paths give identical results.
  *
  * @param game Pointer to the t_game structure containing game data.
- * @param vars Pointer to the t_vars structure containing overall game data.
- * @param rc Pointer to the t_ray_cast structure with current raycasting information.
+ * @param rc Array of initialized rays.
+ * @param count Number of rays in the array, at most RAY_PACKET.
  */
-void process_ray_casting(t_game *game, t_vars *vars, t_ray_cast *rc)
+void trace_rays(t_game *game, t_ray_cast *rc, int count)
 {
-	perform_dda(game, rc);
-	render_column(game, vars, rc);
+	int	i;
+
+	i = 0;
+	if (game->occ.enabled)
+	{
+		while (i < count)
+			perform_dda_skip(game, &rc[i++]);
+		return ;
+	}
+	if (count == RAY_PACKET)
+		return (perform_dda_packet(game, rc));
+	while (i < count)
+		perform_dda(game, &rc[i++]);
 }
 
 /**
@@ -103,8 +120,8 @@ void initialize_ray_position(t_game *game, t_ray_cast *rc)
 /**
  * @brief Calculates the direction of the ray for the current screen column.
  *
- * This function computes the camera plane coordinate (camera_x) for the current column (rc->x)
- * and then calculates the ray direction vector (ray_dir_x, ray_dir_y) by adding the scaled plane vector
+ * This function reads the camera plane coordinate (camera_x) of the current column (rc->x)
+ * from the precomputed table (see tables_build()) and then calculates the ray direction vector (ray_dir_x, ray_dir_y) by adding the scaled plane vector
  * to the player's direction vector.
  *
  * @param game Pointer to the t_game structure containing the player's direction and camera plane.
@@ -112,7 +129,7 @@ void initialize_ray_position(t_game *game, t_ray_cast *rc)
  */
 void calculate_ray_direction(t_game *game, t_ray_cast *rc)
 {
-	rc->camera_x = 2 * rc->x / (double)WIDTH - 1;
+	rc->camera_x = game->tables.camera_x[rc->x];
 	rc->ray_dir_x = game->dir_x + game->plane_x * rc->camera_x;
 	rc->ray_dir_y = game->dir_y + game->plane_y * rc->camera_x;
 }
@@ -0,0 +1,150 @@
+#include "../include/cub3d.h"
+
+#ifdef __SSE2__
+
+/**
+ * @brief Expands two lane bits into a double-precision lane mask.
+ *
+ * @param bits Lane bits; bit 0 selects the low lane, bit 1 the high lane.
+ * @return __m128d All ones in every selected lane, zero elsewhere.
+ */
+static __m128d lane_mask(int bits)
+{
+	return (_mm_castsi128_pd(_mm_set_epi64x(-(long long)((bits >> 1) & 1),
+				-(long long)(bits & 1))));
+}
+
+/**
+ * @brief Moves every active ray of the packet one cell and tests the cells it entered.
+ *
+ * The side distances were already advanced by the vector step; here each active lane moves
+ * along x when its bit in xbits is set (the scalar path's side_dist_x < side_dist_y case) or
+ * along y otherwise, and its new cell is read from the map. Lanes that hit a wall are retired.
+ *
+ * @param game Pointer to the t_game structure containing the world map.
+ * @param rc Array of RAY_PACKET rays.
+ * @param active Bit mask of the rays that have not hit yet.
+ * @param xbits Bit mask of the rays that step along x.
+ * @return int The updated mask of active rays.
+ */
+static int packet_step(t_game *game, t_ray_cast *rc, int active, int xbits)
+{
+	int	cell;
+	int	i;
+
+	i = -1;
+	while (++i < RAY_PACKET)
+	{
+		if (!(active & (1 << i)))
+			continue ;
+		rc[i].side = !(xbits & (1 << i));
+		if (rc[i].side == 0)
+			rc[i].map_x += rc[i].step_x;
+		else
+			rc[i].map_y += rc[i].step_y;
+		cell = *map_cell(game, rc[i].map_x, rc[i].map_y);
+		if (cell != 0 && cell != 3)
+		{
+			rc[i].hit = 1;
+			active &= ~(1 << i);
+		}
+	}
+	return (active);
+}
+
+/**
+ * @brief Loads (store = 0) or stores (store = 1) the side distances of a packet.
+ *
+ * @param rc Array of RAY_PACKET rays.
+ * @param sd Side distances, x in sd[0..RAY_PACKET / 2) and y after them.
+ * @param store Direction of the copy.
+ */
+static void packet_side_dist(t_ray_cast *rc, __m128d *sd, int store)
+{
+	int	i;
+
+	i = -1;
+	while (++i < RAY_PACKET / 2)
+	{
+		if (!store)
+		{
+			sd[i] = _mm_set_pd(rc[2 * i + 1].side_dist_x, rc[2 * i].side_dist_x);
+			sd[i + RAY_PACKET / 2] = _mm_set_pd(rc[2 * i + 1].side_dist_y,
+					rc[2 * i].side_dist_y);
+			continue ;
+		}
+		_mm_storel_pd(&rc[2 * i].side_dist_x, sd[i]);
+		_mm_storeh_pd(&rc[2 * i + 1].side_dist_x, sd[i]);
+		_mm_storel_pd(&rc[2 * i].side_dist_y, sd[i + RAY_PACKET / 2]);
+		_mm_storeh_pd(&rc[2 * i + 1].side_dist_y, sd[i + RAY_PACKET / 2]);
+	}
+}
+
+/**
+ * @brief Runs the DDA for a packet of RAY_PACKET adjacent rays at once.
+ *
+ * The side and delta distances are kept in structure-of-arrays form, two rays per SSE2
+ * register. Every iteration compares side_dist_x < side_dist_y for all rays, adds the delta
+ * distance to the chosen side under a mask (a masked-off lane adds +0.0, which leaves its
+ * value unchanged), and then moves the active rays and tests their cells. Rays that already
+ * hit stay idle until the whole packet is done. Each ray performs exactly the same IEEE
+ * operations as perform_dda(), so the results are bit-identical to the scalar path.
+ *
+ * @param game Pointer to the t_game structure containing the world map.
+ * @param rc Array of RAY_PACKET initialized rays.
+ */
+void perform_dda_packet(t_game *game, t_ray_cast *rc)
+{
+	__m128d	sd[RAY_PACKET];
+	__m128d	dd[RAY_PACKET];
+	__m128d	lt;
+	int		active;
+	int		xbits;
+	int		i;
+
+	packet_side_dist(rc, sd, 0);
+	i = -1;
+	while (++i < RAY_PACKET / 2)
+	{
+		dd[i] = _mm_set_pd(rc[2 * i + 1].delta_dist_x, rc[2 * i].delta_dist_x);
+		dd[i + RAY_PACKET / 2] = _mm_set_pd(rc[2 * i + 1].delta_dist_y,
+				rc[2 * i].delta_dist_y);
+	}
+	active = (1 << RAY_PACKET) - 1;
+	while (active)
+	{
+		xbits = 0;
+		i = -1;
+		while (++i < RAY_PACKET / 2)
+		{
+			lt = _mm_cmplt_pd(sd[i], sd[i + RAY_PACKET / 2]);
+			sd[i] = _mm_add_pd(sd[i], _mm_and_pd(dd[i],
+						_mm_and_pd(lt, lane_mask(active >> (2 * i)))));
+			sd[i + RAY_PACKET / 2] = _mm_add_pd(sd[i + RAY_PACKET / 2],
+					_mm_and_pd(dd[i + RAY_PACKET / 2],
+						_mm_andnot_pd(lt, lane_mask(active >> (2 * i)))));
+			xbits |= _mm_movemask_pd(lt) << (2 * i);
+		}
+		active = packet_step(game, rc, active, xbits);
+	}
+	packet_side_dist(rc, sd, 1);
+}
+
+#else
+
+/**
+ * @brief Runs the DDA for a packet of RAY_PACKET rays (scalar fallback without SSE2).
+ *
+ * @param game Pointer to the t_game structure containing the world map.
+ * @param rc Array of RAY_PACKET initialized rays.
+ */
+void perform_dda_packet(t_game *game, t_ray_cast *rc)
+{
+	int	i;
+
+	i = 0;
+	while (i < RAY_PACKET)
+		perform_dda(game, &rc[i++]);
+}
+
+#endif
@@ -0,0 +1,124 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Returns the side distance at which a ray takes its n-th step along one axis.
+ *
+ * @param side_dist Current side distance on the axis.
+ * @param delta_dist Delta distance on the axis.
+ * @param n Number of steps already taken, counted from the current cell.
+ * @return double side_dist + n * delta_dist, without turning 0 * inf into NaN.
+ */
+static double side_after(double side_dist, double delta_dist, int n)
+{
+	if (n == 0)
+		return (side_dist);
+	return (side_dist + n * delta_dist);
+}
+
+/**
+ * @brief Counts the steps a ray can take along each axis without leaving an empty block.
+ *
+ * n[0] and n[1] receive the number of x and y steps that bring the ray out of the block.
+ * Whichever exit comes first (by side distance) is taken minus one step, and the steps on
+ * the other axis that happen before it are derived from the side distances: y steps are
+ * taken while side_dist_y <= side_dist_x and x steps while side_dist_x < side_dist_y, as in
+ * perform_dda(). Both counts are clamped inside the block, so even a rounding difference
+ * can only land the ray on another cell of the same empty block.
+ *
+ * @param rc Pointer to the ray.
+ * @param shift Log2 of the block size.
+ * @param n Array receiving the x and y step counts.
+ */
+static void block_steps(t_ray_cast *rc, int shift, int *n)
+{
+	int		first[2];
+	double	exit[2];
+	double	c;
+
+	first[0] = (((rc->map_x + 1) >> shift) << shift) - 1;
+	first[1] = (((rc->map_y + 1) >> shift) << shift) - 1;
+	n[0] = rc->map_x - first[0];
+	if (rc->step_x > 0)
+		n[0] = first[0] + (1 << shift) - 1 - rc->map_x;
+	n[1] = rc->map_y - first[1];
+	if (rc->step_y > 0)
+		n[1] = first[1] + (1 << shift) - 1 - rc->map_y;
+	exit[0] = side_after(rc->side_dist_x, rc->delta_dist_x, n[0]);
+	exit[1] = side_after(rc->side_dist_y, rc->delta_dist_y, n[1]);
+	if (exit[0] < exit[1])
+	{
+		c = -1.0;
+		if (exit[0] >= rc->side_dist_y)
+			c = floor((exit[0] - rc->side_dist_y) / rc->delta_dist_y);
+		if (c + 1.0 < n[1])
+			n[1] = (int)(c + 1.0);
+		return ;
+	}
+	c = 0.0;
+	if (exit[1] > rc->side_dist_x)
+		c = ceil((exit[1] - rc->side_dist_x) / rc->delta_dist_x);
+	if (c < n[0])
+		n[0] = (int)c;
+}
+
+/**
+ * @brief Moves a ray across the empty block of the given level that holds its cell.
+ *
+ * @param rc Pointer to the ray.
+ * @param shift Log2 of the block size.
+ */
+static void skip_block(t_ray_cast *rc, int shift)
+{
+	int	n[2];
+
+	block_steps(rc, shift, n);
+	rc->side_dist_x = side_after(rc->side_dist_x, rc->delta_dist_x, n[0]);
+	rc->side_dist_y = side_after(rc->side_dist_y, rc->delta_dist_y, n[1]);
+	rc->map_x += n[0] * rc->step_x;
+	rc->map_y += n[1] * rc->step_y;
+}
+
+/**
+ * @brief Performs the DDA with empty-space skipping through the occupancy pyramid.
+ *
+ * Before every step the ray checks the 8x8 block holding its cell; if it has no solid
+ * cell, the 64x64 block is checked too, and the ray jumps to the last cell it would visit
+ * inside the largest empty block before taking a normal step out of it. Near walls it steps
+ * cell by cell exactly like perform_dda(), so the cost of a ray grows with the number of
+ * non-empty blocks it crosses instead of the distance it travels. Rays with an undefined
+ * (NaN) side distance are never skipped.
+ *
+ * @param game Pointer to the t_game structure containing the world grid and pyramid.
+ * @param rc Pointer to the t_ray_cast structure containing current raycasting data.
+ */
+void perform_dda_skip(t_game *game, t_ray_cast *rc)
+{
+	int	cell;
+
+	while (!(rc->hit))
+	{
+		if (*occ_block(game, 0, rc->map_x, rc->map_y) == 0
+			&& !isnan(rc->side_dist_x) && !isnan(rc->side_dist_y))
+		{
+			if (*occ_block(game, 1, rc->map_x, rc->map_y) == 0)
+				skip_block(rc, 2 * OCC_SHIFT);
+			else
+				skip_block(rc, OCC_SHIFT);
+		}
+		if (rc->side_dist_x < rc->side_dist_y)
+		{
+			rc->side_dist_x += rc->delta_dist_x;
+			rc->map_x += rc->step_x;
+			rc->side = 0;
+		}
+		else
+		{
+			rc->side_dist_y += rc->delta_dist_y;
+			rc->map_y += rc->step_y;
+			rc->side = 1;
+		}
+		cell = *map_cell(game, rc->map_x, rc->map_y);
+		if (cell != 0 && cell != 3)
+			rc->hit = 1;
+	}
+}
@@ -0,0 +1,84 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Loads a map and prepares a headless renderer for it.
+ *
+ * This is the entry point for embedding the raycaster in another program (a test, a server,
+ * an offline tool). It parses and validates the ".cub" file, loads its textures and starts
+ * the worker pool exactly like the game does, but with the headless backend: no window is
+ * opened and no X display is needed. width and height override the resolution of the map
+ * file when they lie within [MIN_RESOLUTION, MAX_RESOLUTION]; pass 0 to keep it. As in the
+ * game, an invalid map or texture prints an error and exits.
+ *
+ * @param map_path Path of the ".cub" file.
+ * @param width Width of the frames that will be rendered, or 0.
+ * @param height Height of the frames that will be rendered, or 0.
+ * @return t_vars* The renderer, to be released with render_close().
+ */
+t_vars *render_open(char *map_path, int width, int height)
+{
+	t_vars	*vars;
+
+	init_vars(&vars);
+	vars->game->backend = backend_headless();
+	check_map_exists(map_path, vars);
+	read_fd_file(vars);
+	if (check_map_valid(vars) == ERROR)
+		exit(1);
+	if (width >= MIN_RESOLUTION && width <= MAX_RESOLUTION
+		&& height >= MIN_RESOLUTION && height <= MAX_RESOLUTION)
+	{
+		vars->game->width = width;
+		vars->game->height = height;
+	}
+	init_window(vars);
+	load_textures(vars);
+	fog_set(vars, vars->game->fog.distance, vars->game->fog.color);
+	pool_init(&vars->game->pool, render_thread_count());
+	return (vars);
+}
+
+/**
+ * @brief Renders one frame from a camera straight into a caller-provided pixel buffer.
+ *
+ * out must be exactly game->width x game->height; its pitch (in pixels) may be larger than
+ * the width, so the frame can be a window into a bigger buffer. At render scale 1 the scene is
+ * raycast directly into out->pixels, with no intermediate copy; at lower scales it is upscaled
+ * into it. Switching buffers only rebuilds the render target, so rendering repeatedly into the
+ * same buffer costs nothing extra. Pixels are 0x00RRGGBB, the layout of the MLX image. Doors
+ * show the animation frame last set with door_anim_set(), the first one unless the caller
+ * sets another, so repeated renders of the same camera give the same pixels.
+ *
+ * @param game Pointer to the t_game structure of a renderer opened with render_open().
+ * @param cam Position (in map cells), direction and camera plane to render from.
+ * @param out The frame to render into.
+ * @return int Returns OK on success, or ERROR if the frame size does not match or the camera
+ * is outside the map.
+ */
+int render_frame(t_game *game, t_camera *cam, t_frame *out)
+{
+	if (!out->pixels || out->width != game->width || out->height != game->height
+		|| out->pitch < out->width || !(cam->x >= 0 && cam->x < game->map_width)
+		|| !(cam->y >= 0 && cam->y < game->map_height))
+		return (ERROR);
+	camera_set(game, cam);
+	if (out->pixels != game->output.pixels || out->pitch != game->output.pitch)
+	{
+		game->output = *out;
+		render_resize(game, game->render_scale);
+	}
+	render_scene(game);
+	return (OK);
+}
+
+/**
+ * @brief Releases a renderer opened with render_open().
+ *
+ * The caller's pixel buffers are not freed.
+ *
+ * @param vars The renderer.
+ */
+void render_close(t_vars *vars)
+{
+	clean_exit(vars);
+}
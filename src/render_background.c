@@ -0,0 +1,49 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Computes the fogged background color of a screen row.
+ *
+ * Rows above the horizon show the ceiling and rows below it show the floor. The distance
+ * of a row only depends on how far it is from the horizon (see tables_build()), so the
+ * shaded color is the same for every column of the screen.
+ *
+ * @param game Pointer to the t_game structure holding the fog and row tables.
+ * @param y The row of the render target.
+ * @return unsigned int The background color of the row.
+ */
+static unsigned int background_row(t_game *game, int y)
+{
+	int	level;
+
+	level = fog_level(&game->fog, game->tables.row_dist[y]);
+	if (y < game->render_h / 2)
+		return (game->fog.ceiling[level]);
+	return (game->fog.floor[level]);
+}
+
+/**
+ * @brief Builds the fogged floor and ceiling background.
+ *
+ * Since every screen column has the same background, a single column of render_h pixels is
+ * stored; in the column-major frame buffer it has exactly the layout of a frame column, so
+ * drawing the background is a plain memory copy. It has to be rebuilt whenever the resolution,
+ * the floor and ceiling colors or the fog settings change, and never while a frame is rendering.
+ *
+ * @param game Pointer to the t_game structure holding the fog tables and the background.
+ */
+void background_build(t_game *game)
+{
+	int	y;
+
+	free(game->background);
+	game->background = aligned_alloc(64, ((game->render_h * sizeof(unsigned int)
+					+ 63) / 64) * 64);
+	if (!game->background)
+		return (perror("malloc"), exit(ERROR));
+	y = 0;
+	while (y < game->render_h)
+	{
+		game->background[y] = background_row(game, y);
+		y++;
+	}
+}
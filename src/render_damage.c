@@ -0,0 +1,130 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Tells whether the camera or the render resolution changed since the last drawn scene.
+ *
+ * @param game Pointer to the t_game structure holding the current camera.
+ * @param dm Pointer to the t_damage structure holding the camera of the last drawn scene.
+ * @return int 1 if anything the raycaster depends on moved, 0 otherwise.
+ */
+static int view_changed(t_game *game, t_damage *dm)
+{
+	return (dm->view[0] != game->player_x || dm->view[1] != game->player_y
+		|| dm->view[2] != game->dir_x || dm->view[3] != game->dir_y
+		|| dm->view[4] != game->plane_x || dm->view[5] != game->plane_y
+		|| dm->render_w != game->render_w || dm->render_h != game->render_h);
+}
+
+/**
+ * @brief Records the state the scene is about to be drawn from.
+ *
+ * @param game Pointer to the t_game structure holding the current state.
+ * @param dm Pointer to the t_damage structure receiving the snapshot.
+ */
+static void damage_snapshot(t_game *game, t_damage *dm)
+{
+	dm->view[0] = game->player_x;
+	dm->view[1] = game->player_y;
+	dm->view[2] = game->dir_x;
+	dm->view[3] = game->dir_y;
+	dm->view[4] = game->plane_x;
+	dm->view[5] = game->plane_y;
+	dm->render_w = game->render_w;
+	dm->render_h = game->render_h;
+	dm->drawn_gen = dm->map_gen;
+	dm->door_step = game->anim.step;
+	atomic_store_explicit(&dm->doors_seen, 0, memory_order_relaxed);
+}
+
+/**
+ * @brief Works out which parts of the window have to be redrawn this frame.
+ *
+ * The scene is damaged when the camera or the render resolution changed since it was last
+ * drawn, when the map changed (map_set() bumps map_gen), or when the last scene showed a
+ * closed door and the door animation has moved on to another frame since. A new scene has to be presented, and presenting
+ * the image covers the minimap, which is drawn straight to the window; the minimap is also
+ * damaged on its own when the player enters another cell. Damage requested from outside
+ * (the first frame, an Expose event) is added and cleared. When the scene is damaged the
+ * current state is recorded, so the next frame compares against what is drawn now.
+ *
+ * @param game Pointer to the t_game structure.
+ * @return int A combination of DAMAGE_SCENE, DAMAGE_PRESENT and DAMAGE_MINIMAP, 0 if the
+ *             window is up to date.
+ */
+int damage_collect(t_game *game)
+{
+	t_damage	*dm;
+	int			damage;
+
+	dm = &game->damage;
+	damage = dm->pending;
+	dm->pending = 0;
+	if (view_changed(game, dm) || dm->map_gen != dm->drawn_gen
+		|| (atomic_load_explicit(&dm->doors_seen, memory_order_relaxed)
+			&& dm->door_step != game->anim.step))
+		damage |= DAMAGE_SCENE;
+	if (damage & DAMAGE_SCENE)
+	{
+		damage_snapshot(game, dm);
+		damage |= DAMAGE_PRESENT;
+	}
+	if (damage & DAMAGE_PRESENT || dm->cell_x != (int)game->player_x
+		|| dm->cell_y != (int)game->player_y)
+		damage |= DAMAGE_MINIMAP;
+	dm->cell_x = (int)game->player_x;
+	dm->cell_y = (int)game->player_y;
+	return (damage);
+}
+
+/**
+ * @brief Works out how long the loop may sleep after a frame before the next one is due.
+ *
+ * A frame that drew or presented something is followed at once by the next one. Otherwise
+ * nothing on screen changes until an event arrives, except for what the clock drives: while a
+ * movement key is held or the door cooldown runs, the simulation needs its next tick, and
+ * while a closed door is on screen, the door animation needs its next frame. Key presses,
+ * mouse movement and Expose events wake the loop by themselves. When the simulation has
+ * nothing to do, its clock is paused (see sim_pause()), so the time spent asleep is not
+ * simulated on waking.
+ *
+ * @param game Pointer to the t_game structure.
+ * @param damage The damage flags of the frame (see damage_collect()).
+ * @return long Microseconds until the next frame is due, 0 for right away, or -1 to wait for
+ *              events only.
+ */
+long damage_idle_us(t_game *game, int damage)
+{
+	unsigned long long	tick;
+	unsigned long long	next;
+
+	if (damage)
+		return (0);
+	tick = 1000000000ULL / SIM_HZ;
+	if (game->key_w || game->key_a || game->key_s || game->key_d
+		|| game->key_left || game->key_right || game->key_e
+		|| game->door_cooldown > 0)
+		return ((tick - game->sim.acc) / 1000 + 1);
+	sim_pause(game);
+	if (!atomic_load_explicit(&game->damage.doors_seen, memory_order_relaxed))
+		return (-1);
+	next = game->anim.start + (game->anim.step + 1) * (1000000000ULL / DOOR_FPS);
+	tick = stage_clock();
+	if (next <= tick)
+		return (0);
+	return ((next - tick) / 1000 + 1);
+}
+
+/**
+ * @brief Handles Expose events by presenting the last frame again.
+ *
+ * The image still holds the last drawn frame, so nothing is raycast: the image is put to the
+ * window again and the minimap is redrawn on top of it.
+ *
+ * @param vars Pointer to the t_vars structure containing the game state.
+ * @return int Always returns 0.
+ */
+int damage_expose(t_vars *vars)
+{
+	vars->game->damage.pending |= DAMAGE_PRESENT | DAMAGE_MINIMAP;
+	return (0);
+}
@@ -0,0 +1,78 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Fills a buffer of 32-bit pixels with the coverage poison value.
+ *
+ * @param pixels Pointer to the first pixel.
+ * @param count Number of pixels to fill.
+ */
+static void fill_poison(unsigned int *pixels, size_t count)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < count)
+		pixels[i++] = COVERAGE_POISON;
+}
+
+/**
+ * @brief Poisons the frame buffers before a frame is rendered (debug builds).
+ *
+ * COVERAGE_POISON has its alpha byte set, which the renderer never produces (fog shading only
+ * keeps the RGB channels), so any pixel still holding it after the frame was never written.
+ *
+ * The column buffer, the low-resolution target (when the render scale is below 1) and the
+ * window-sized output frame are all poisoned, so a gap in either the render or the upscale shows up.
+ *
+ * @param game Pointer to the t_game structure holding the frame buffers.
+ */
+void coverage_poison(t_game *game)
+{
+	int	y;
+
+	fill_poison(game->colbuf, (size_t)game->render_w * game->render_h);
+	fill_poison(game->lowres, (size_t)game->render_w * game->render_h);
+	y = 0;
+	while (y < game->height)
+	{
+		fill_poison(game->output.pixels + (size_t)y * game->output.pitch,
+			game->width);
+		y++;
+	}
+}
+
+/**
+ * @brief Reports pixels a frame left unwritten (debug builds).
+ *
+ * Scans the output frame for the poison value written by coverage_poison() and prints the number of
+ * uncovered pixels and the first one found to stderr.
+ *
+ * @param game Pointer to the t_game structure holding the output frame.
+ */
+void coverage_check(t_game *game)
+{
+	unsigned int	*row;
+	long			missed;
+	int				first[2];
+	int				x;
+	int				y;
+
+	missed = 0;
+	y = -1;
+	while (++y < game->height)
+	{
+		row = game->output.pixels + (size_t)y * game->output.pitch;
+		x = -1;
+		while (++x < game->width)
+		{
+			if (row[x] == COVERAGE_POISON && missed++ == 0)
+			{
+				first[0] = x;
+				first[1] = y;
+			}
+		}
+	}
+	if (missed)
+		fprintf(stderr, "coverage: %ld pixels left unwritten, first at (%d, %d)\n",
+			missed, first[0], first[1]);
+}
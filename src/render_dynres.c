@@ -0,0 +1,131 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Returns the average of the frame times currently in the window.
+ *
+ * @param dr Pointer to the t_dynres structure holding the frame times.
+ * @return double The average frame time in milliseconds.
+ */
+static double dynres_average(t_dynres *dr)
+{
+	double	sum;
+	int		n;
+	int		i;
+
+	n = dr->count;
+	if (n > DYNRES_WINDOW)
+		n = DYNRES_WINDOW;
+	sum = 0.0;
+	i = 0;
+	while (i < n)
+		sum += dr->frame_ms[i++];
+	return (sum / n);
+}
+
+/**
+ * @brief Picks the render scale for the next frames from the average frame time.
+ *
+ * The cost of a frame grows with the number of rendered pixels, i.e. with the square of the
+ * scale. Over budget, the scale drops straight to the value that should meet it (at least by
+ * DYNRES_STEP). Under DYNRES_LOW of the budget it only climbs by DYNRES_STEP, and only if the
+ * predicted frame time still fits the budget. Anything in between keeps the current scale, so
+ * the two thresholds form a dead band that stops the resolution from oscillating.
+ *
+ * @param dr Pointer to the t_dynres structure with the budget and the frame times.
+ * @param scale The current render scale.
+ * @return double The new render scale, which may equal the current one.
+ */
+static double dynres_target(t_dynres *dr, double scale)
+{
+	double	target;
+
+	target = scale;
+	if (dr->avg_ms > dr->budget_ms)
+	{
+		target = scale * sqrt(dr->budget_ms / dr->avg_ms);
+		if (target > scale - DYNRES_STEP)
+			target = scale - DYNRES_STEP;
+	}
+	else if (dr->avg_ms < dr->budget_ms * DYNRES_LOW)
+	{
+		target = scale + DYNRES_STEP;
+		if (dr->avg_ms * (target * target) / (scale * scale) > dr->budget_ms)
+			target = scale;
+	}
+	if (target > dr->max_scale)
+		target = dr->max_scale;
+	if (target < MIN_RENDER_SCALE)
+		target = MIN_RENDER_SCALE;
+	return (target);
+}
+
+/**
+ * @brief Prepares the dynamic resolution controller.
+ *
+ * The configured render scale becomes the upper limit the controller may climb back to. With
+ * a budget of 0 (the default, see the "-t" option) frame times are still measured but the
+ * scale is never changed.
+ *
+ * @param game Pointer to the t_game structure holding the controller state.
+ */
+void dynres_init(t_game *game)
+{
+	game->dynres.max_scale = game->render_scale;
+	game->dynres.count = 0;
+	game->dynres.cooldown = 0;
+	game->dynres.last_ms = 0.0;
+	game->dynres.avg_ms = 0.0;
+}
+
+/**
+ * @brief Marks the start of a frame for the dynamic resolution controller.
+ *
+ * @param game Pointer to the t_game structure holding the controller state.
+ */
+void dynres_begin(t_game *game)
+{
+	clock_gettime(CLOCK_MONOTONIC, &game->dynres.start);
+}
+
+/**
+ * @brief Records the time of the frame that just finished and adapts the render scale.
+ *
+ * The last frame time and the average over the last DYNRES_WINDOW frames are kept in
+ * game->dynres (last_ms, avg_ms) and the current scale in game->render_scale, so they can be
+ * logged. Once the window is full, count wraps between DYNRES_WINDOW and twice that, so it
+ * keeps pointing at the oldest slot without ever overflowing, however long the controller is
+ * off or the scale stays put. A decision is only taken once the window is full; after every
+ * change the next DYNRES_COOLDOWN frames are ignored and the window is emptied, so the new
+ * scale is judged only on settled frames of its own. Debug builds print every change to
+ * stderr. It runs between frames, when render_resize() is
+ * safe to call.
+ *
+ * @param game Pointer to the t_game structure holding the controller state.
+ */
+void dynres_end(t_game *game)
+{
+	t_dynres		*dr;
+	struct timespec	now;
+	double			target;
+
+	dr = &game->dynres;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	dr->last_ms = (now.tv_sec - dr->start.tv_sec) * 1e3
+		+ (now.tv_nsec - dr->start.tv_nsec) / 1e6;
+	dr->frame_ms[dr->count++ % DYNRES_WINDOW] = dr->last_ms;
+	if (dr->count == 2 * DYNRES_WINDOW)
+		dr->count = DYNRES_WINDOW;
+	dr->avg_ms = dynres_average(dr);
+	if (dr->cooldown > 0 && --dr->cooldown == 0)
+		dr->count = 0;
+	if (dr->budget_ms <= 0.0 || dr->cooldown > 0 || dr->count < DYNRES_WINDOW)
+		return ;
+	target = dynres_target(dr, game->render_scale);
+	if (fabs(target - game->render_scale) < 1e-9)
+		return ;
+	if (DEBUG)
+		fprintf(stderr, "dynres: %.2f ms avg, scale %.2f -> %.2f\n",
+			dr->avg_ms, game->render_scale, target);
+	render_resize(game, target);
+	dr->cooldown = DYNRES_COOLDOWN;
+}
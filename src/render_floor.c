@@ -0,0 +1,142 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Converts a world coordinate into a 0.32 fixed-point position inside its cell.
+ *
+ * Only the fraction survives the conversion, and since the floor and ceiling textures repeat
+ * in every cell that is all the caster needs: adding a step wraps around exactly like moving
+ * into the next cell.
+ *
+ * @param v The world coordinate.
+ * @return uint32_t The position inside the cell, 0 at its start and 2^32 at its end.
+ */
+static uint32_t cell_fraction(double v)
+{
+	return ((uint32_t)(int64_t)(v * 4294967296.0));
+}
+
+/**
+ * @brief Selects the mip level to texture a floor or ceiling row with.
+ *
+ * As for walls (see select_mip()), the smallest level that is still sampled at least once per
+ * screen pixel is used. The footprint of a pixel is the larger of its world-space step along
+ * the row and between two rows, so distant rows do not alias in depth either.
+ *
+ * @param texture Pointer to the floor or ceiling texture.
+ * @param step World-space footprint of one screen pixel on the row.
+ * @return t_mip* Pointer to the chosen mip level.
+ */
+static t_mip *row_mip(t_texture *texture, double step)
+{
+	int	level;
+
+	level = 0;
+	while (level + 1 < texture->mip_count
+		&& texture->mips[level + 1].width * step >= 1.0
+		&& texture->mips[level + 1].height * step >= 1.0)
+		level++;
+	return (&texture->mips[level]);
+}
+
+/**
+ * @brief Sets up the scanline of a floor or ceiling row.
+ *
+ * Every pixel of a row sees the floor (or ceiling) at the same distance, row_dist[y], so the
+ * world position under column x is linear in x: the left edge is player + dist * (dir - plane)
+ * and each column adds dist * 2 * plane / render_w. The start and the step are converted once
+ * to 0.32 fixed point, and the fog of the row is resolved once.
+ *
+ * @param game Pointer to the t_game structure holding the camera, tables and textures.
+ * @param sl Pointer to the t_scanline structure to fill.
+ * @param y The row of the render target.
+ * @param texture Pointer to the texture of the row's surface.
+ */
+static void scanline_init(t_game *game, t_scanline *sl, int y, t_texture *texture)
+{
+	double	dist;
+	double	step_x;
+	double	step_y;
+	int		level;
+
+	dist = game->tables.row_dist[y];
+	step_x = dist * 2 * game->plane_x / game->render_w;
+	step_y = dist * 2 * game->plane_y / game->render_w;
+	sl->u = cell_fraction(game->player_x + dist * (game->dir_x - game->plane_x));
+	sl->v = cell_fraction(game->player_y + dist * (game->dir_y - game->plane_y));
+	sl->du = cell_fraction(step_x);
+	sl->dv = cell_fraction(step_y);
+	sl->mip = row_mip(texture, fmax(fmax(fabs(step_x), fabs(step_y)),
+				2 * dist * dist / game->render_h));
+	sl->w = sl->mip->width;
+	sl->h = sl->mip->height;
+	level = fog_level(&game->fog, dist);
+	sl->fog_scale = game->fog.scale[level];
+	sl->fog_add = game->fog.add[level];
+	sl->row = game->target.pixels + (size_t)y * game->target.pitch;
+	sl->floor = y >= game->render_h / 2;
+}
+
+/**
+ * @brief Casts one band of FLOOR_BAND rows of the textured floor and ceiling.
+ *
+ * This function is the task run by the worker pool. Rows above the horizon show the ceiling
+ * and rows below it the floor, as in background_build(); rows of a surface without a texture
+ * keep the flat background the columns already drew, and rows that a wall covers in every
+ * column are skipped without looking at them.
+ *
+ * @param ctx Pointer to the t_game structure.
+ * @param band Index of the band to draw.
+ */
+static void floor_band(void *ctx, int band)
+{
+	t_game		*game;
+	t_texture	*texture;
+	t_scanline	sl;
+	int			y;
+
+	game = (t_game *)ctx;
+	y = band * FLOOR_BAND - 1;
+	while (++y < (band + 1) * FLOOR_BAND && y < game->render_h)
+	{
+		if (y >= game->covered.top && y < game->covered.bottom)
+			continue ;
+		texture = &game->tex[CEILING];
+		if (y >= game->render_h / 2)
+			texture = &game->tex[FLOOR];
+		if (!texture->mip_count)
+			continue ;
+		scanline_init(game, &sl, y, texture);
+		scanline_draw(game, &sl, y);
+	}
+}
+
+/**
+ * @brief Draws the textured floor and ceiling over the rendered walls.
+ *
+ * Unlike the walls, the floor and ceiling are cast row by row: along a screen row the distance
+ * is constant, so the texture position steps linearly and the frame is written sequentially.
+ * It runs after the column tiles are transposed into the render target, since it only fills
+ * the pixels outside the wall spans they recorded, and before the upscale. The rows every
+ * wall span covers are collected first into game->covered. Does nothing when neither
+ * surface has a texture.
+ *
+ * @param game Pointer to the t_game structure.
+ */
+void render_floor(t_game *game)
+{
+	int	x;
+
+	if (!game->tex[FLOOR].mip_count && !game->tex[CEILING].mip_count)
+		return ;
+	game->covered = game->spans[0];
+	x = 0;
+	while (++x < game->render_w)
+	{
+		if (game->spans[x].top > game->covered.top)
+			game->covered.top = game->spans[x].top;
+		if (game->spans[x].bottom < game->covered.bottom)
+			game->covered.bottom = game->spans[x].bottom;
+	}
+	pool_run(&game->pool, floor_band, game,
+		(game->render_h + FLOOR_BAND - 1) / FLOOR_BAND);
+}
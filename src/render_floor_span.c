@@ -0,0 +1,167 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Draws the visible pixels of a floor or ceiling row from column x on, one at a time.
+ *
+ * The texel under a pixel is found with two multiply-shifts of the 0.32 cell position, which
+ * works for any texture size, and shaded with the row's fog like a wall texel. Pixels covered
+ * by the wall of their column (see game->spans) are skipped but still advance the position.
+ * The scanline is copied into locals first: the frame row could alias it, which would force
+ * every field to be reloaded per pixel.
+ *
+ * @param game Pointer to the t_game structure holding the wall spans.
+ * @param sl Pointer to the scanline, positioned at column x.
+ * @param y The row of the render target.
+ * @param x The first column to draw.
+ */
+static void span_scalar(t_game *game, t_scanline *sl, int y, int x)
+{
+	t_scanline		s;
+	unsigned int	texel;
+
+	s = *sl;
+	while (x < game->render_w)
+	{
+		if ((s.floor && y >= game->spans[x].bottom)
+			|| (!s.floor && y < game->spans[x].top))
+		{
+			texel = s.mip->columns[(((s.u >> 16) * s.w) >> 16) * s.h
+				+ (((s.v >> 16) * s.h) >> 16)];
+			s.row[x] = ((((texel & 0xFF00FF) * s.fog_scale) >> 8) & 0xFF00FF)
+				+ ((((texel & 0x00FF00) * s.fog_scale) >> 8) & 0x00FF00)
+				+ s.fog_add;
+		}
+		s.u += s.du;
+		s.v += s.dv;
+		x++;
+	}
+}
+
+#ifdef __SSE2__
+
+/**
+ * @brief Returns the mask of the four pixels from column x on that show the floor or ceiling.
+ *
+ * The four spans are loaded as two vectors and their tops or bottoms picked with a shuffle.
+ * A floor pixel is visible when the wall of its column ends at or above the row, a ceiling
+ * pixel when the wall starts below it.
+ *
+ * @param span Pointer to the span of column x.
+ * @param y Row broadcast to the four lanes.
+ * @param floor 1 for a floor row, 0 for a ceiling row.
+ * @return __m128i All ones in the lanes of visible pixels, zero elsewhere.
+ */
+static __m128i span_visible(t_span *span, __m128i y, int floor)
+{
+	__m128	lo;
+	__m128	hi;
+
+	lo = _mm_castsi128_ps(_mm_loadu_si128((__m128i *)span));
+	hi = _mm_castsi128_ps(_mm_loadu_si128((__m128i *)(span + 2)));
+	if (floor)
+		return (_mm_xor_si128(_mm_cmpgt_epi32(_mm_castps_si128(
+						_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1))), y),
+				_mm_set1_epi32(-1)));
+	return (_mm_cmpgt_epi32(_mm_castps_si128(
+				_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0))), y));
+}
+
+/**
+ * @brief Fetches the texels under four pixels and applies the row's fog to them.
+ *
+ * The texel indices are computed for all lanes at once with shifts, which is exact for the
+ * power-of-two levels this path is used with; the loads themselves are scalar, since SSE2 has
+ * no gather. The shading splits red/blue and green into 16-bit lanes, so the multiplies give
+ * the same (channel * scale) >> 8 as the scalar path.
+ *
+ * @param s Pointer to the scanline (mip level and fog).
+ * @param u Cell positions along x of the four pixels.
+ * @param v Cell positions along y of the four pixels.
+ * @param shift Shift counts: 32 - log2(width), 32 - log2(height) and log2(height).
+ * @return __m128i The four shaded pixels.
+ */
+static __m128i span_texels(t_scanline *s, __m128i u, __m128i v, __m128i *shift)
+{
+	unsigned int	idx[4];
+	__m128i			texel;
+	__m128i			scale;
+	__m128i			rb;
+	__m128i			g;
+
+	_mm_storeu_si128((__m128i *)idx, _mm_add_epi32(
+			_mm_sll_epi32(_mm_srl_epi32(u, shift[0]), shift[2]),
+			_mm_srl_epi32(v, shift[1])));
+	texel = _mm_set_epi32(s->mip->columns[idx[3]], s->mip->columns[idx[2]],
+			s->mip->columns[idx[1]], s->mip->columns[idx[0]]);
+	scale = _mm_set1_epi16((short)s->fog_scale);
+	rb = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(texel,
+					_mm_set1_epi32(0xFF00FF)), scale), 8);
+	g = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi32(texel, 8),
+					_mm_set1_epi32(0xFF)), scale), 8);
+	return (_mm_add_epi32(_mm_or_si128(rb, _mm_slli_epi32(g, 8)),
+			_mm_set1_epi32(s->fog_add)));
+}
+
+/**
+ * @brief Draws the visible pixels of one floor or ceiling row, four at a time.
+ *
+ * Groups where the wall covers every pixel are skipped, fully visible groups are stored
+ * directly and mixed groups are blended with what the columns drew. Levels whose sides are
+ * not powers of two, and the last few columns of the row, go through span_scalar(); both
+ * paths give identical pixels.
+ *
+ * @param game Pointer to the t_game structure holding the wall spans.
+ * @param sl Pointer to the initialized scanline.
+ * @param y The row of the render target.
+ */
+void scanline_draw(t_game *game, t_scanline *sl, int y)
+{
+	__m128i	pos[4];
+	__m128i	shift[3];
+	__m128i	mask;
+	int		x;
+
+	if ((sl->w & (sl->w - 1)) || (sl->h & (sl->h - 1)))
+		return (span_scalar(game, sl, y, 0));
+	shift[0] = _mm_cvtsi32_si128(32 - __builtin_ctz(sl->w));
+	shift[1] = _mm_cvtsi32_si128(32 - __builtin_ctz(sl->h));
+	shift[2] = _mm_cvtsi32_si128(__builtin_ctz(sl->h));
+	pos[0] = _mm_set_epi32(sl->u + 3 * sl->du, sl->u + 2 * sl->du, sl->u + sl->du, sl->u);
+	pos[1] = _mm_set_epi32(sl->v + 3 * sl->dv, sl->v + 2 * sl->dv, sl->v + sl->dv, sl->v);
+	pos[2] = _mm_set1_epi32(4 * sl->du);
+	pos[3] = _mm_set1_epi32(4 * sl->dv);
+	x = 0;
+	while (x + 4 <= game->render_w)
+	{
+		mask = span_visible(game->spans + x, _mm_set1_epi32(y), sl->floor);
+		if (_mm_movemask_epi8(mask) == 0xFFFF)
+			_mm_storeu_si128((__m128i *)(sl->row + x),
+				span_texels(sl, pos[0], pos[1], shift));
+		else if (_mm_movemask_epi8(mask))
+			_mm_storeu_si128((__m128i *)(sl->row + x), _mm_or_si128(
+					_mm_and_si128(mask, span_texels(sl, pos[0], pos[1], shift)),
+					_mm_andnot_si128(mask, _mm_loadu_si128((__m128i *)(sl->row + x)))));
+		pos[0] = _mm_add_epi32(pos[0], pos[2]);
+		pos[1] = _mm_add_epi32(pos[1], pos[3]);
+		x += 4;
+	}
+	sl->u += (uint32_t)x * sl->du;
+	sl->v += (uint32_t)x * sl->dv;
+	span_scalar(game, sl, y, x);
+}
+
+#else
+
+/**
+ * @brief Draws the visible pixels of one floor or ceiling row (scalar fallback without SSE2).
+ *
+ * @param game Pointer to the t_game structure holding the wall spans.
+ * @param sl Pointer to the initialized scanline.
+ * @param y The row of the render target.
+ */
+void scanline_draw(t_game *game, t_scanline *sl, int y)
+{
+	span_scalar(game, sl, y, 0);
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Stretches one band of UPSCALE_BAND window rows out of the low-resolution frame.
+ *
+ * This function is the task run by the worker pool while upscaling. Every window pixel takes the
+ * nearest pixel of the low-resolution frame (the column lookup is precomputed in upscale_x), and
+ * a window row that maps onto the same source row as the one above it is a plain copy of it.
+ *
+ * @param ctx Pointer to the t_game structure holding the frame buffers.
+ * @param band Index of the band to upscale.
+ */
+static void upscale_band(void *ctx, int band)
+{
+	t_game			*game;
+	unsigned int	*src;
+	unsigned int	*dst;
+	int				y;
+	int				x;
+
+	game = (t_game *)ctx;
+	y = band * UPSCALE_BAND - 1;
+	while (++y < (band + 1) * UPSCALE_BAND && y < game->height)
+	{
+		dst = game->output.pixels + (size_t)y * game->output.pitch;
+		if (y > band * UPSCALE_BAND && (long)y * game->render_h / game->height
+			== (long)(y - 1) * game->render_h / game->height)
+		{
+			memcpy(dst, dst - game->output.pitch,
+				game->width * sizeof(unsigned int));
+			continue ;
+		}
+		src = game->target.pixels + (long)y * game->render_h / game->height
+			* game->target.pitch;
+		x = -1;
+		while (++x < game->width)
+			dst[x] = src[game->upscale_x[x]];
+	}
+}
+
+/**
+ * @brief Sets the internal render scale and resizes everything that depends on it.
+ *
+ * The scene is raycast at render_w x render_h (the window size times the scale, rounded) and
+ * stretched to the window afterwards. At scale 1 the render target is the output frame itself and
+ * no upscale pass runs. The frame buffers are allocated once at window size in init_window(),
+ * so changing the scale never allocates anything but the background column. The ray and row
+ * tables and the background column are rebuilt here; it must not be called while a frame is
+ * rendering.
+ *
+ * @param game Pointer to the t_game structure.
+ * @param scale Render scale in (0, 1]; it is clamped to [MIN_RENDER_SCALE, 1].
+ */
+void render_resize(t_game *game, double scale)
+{
+	int	x;
+
+	if (scale < MIN_RENDER_SCALE)
+		scale = MIN_RENDER_SCALE;
+	if (scale > 1.0)
+		scale = 1.0;
+	game->render_scale = scale;
+	game->render_w = (int)(game->width * scale + 0.5);
+	game->render_h = (int)(game->height * scale + 0.5);
+	if (game->render_w == game->width && game->render_h == game->height)
+		game->target = game->output;
+	else
+		game->target = (t_frame){game->lowres, game->render_w,
+			game->render_h, game->render_w};
+	x = -1;
+	while (++x < game->width)
+		game->upscale_x[x] = (long)x * game->render_w / game->width;
+	tables_build(game);
+	background_build(game);
+}
+
+/**
+ * @brief Stretches the low-resolution frame to the whole output frame.
+ *
+ * Does nothing when the scene was rendered straight into the output (render scale 1).
+ * Otherwise the window rows are split into bands that the worker pool upscales in parallel.
+ *
+ * @param game Pointer to the t_game structure holding the frame buffers.
+ */
+void render_upscale(t_game *game)
+{
+	if (game->target.pixels == game->output.pixels)
+		return ;
+	pool_run(&game->pool, upscale_band, game,
+		(game->height + UPSCALE_BAND - 1) / UPSCALE_BAND);
+}
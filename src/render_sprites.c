@@ -0,0 +1,158 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Tells whether any column under a projected sprite shows a wall behind it.
+ *
+ * game->zbuf_tile holds the farthest wall of every RENDER_TILE columns, so one comparison per
+ * tile tells whether the sprite is hidden behind the walls of all of them.
+ *
+ * @param game Pointer to the t_game structure holding the depth buffer.
+ * @param v Pointer to the projected sprite.
+ * @return int 1 if the sprite may be visible, 0 if walls hide all of it.
+ */
+static int sprite_unoccluded(t_game *game, t_sprite_view *v)
+{
+	int	tile;
+
+	tile = v->x0 / RENDER_TILE - 1;
+	while (++tile <= (v->x1 - 1) / RENDER_TILE)
+	{
+		if (game->zbuf_tile[tile] > v->depth)
+			return (1);
+	}
+	return (0);
+}
+
+/**
+ * @brief Fills in the on-screen rectangle, mip level and fog of a projected sprite.
+ *
+ * A sprite is a one-unit square standing on the floor and facing the camera: its height is
+ * render_h / depth, like a wall at the same distance, and its width is one world unit at that
+ * depth across the camera plane. The mip level is the smallest one still as large as the
+ * sprite on screen, as for walls (see select_mip()).
+ *
+ * @param game Pointer to the t_game structure holding the camera and textures.
+ * @param v Pointer to the view to fill; depth must be set.
+ * @param center Screen column of the center of the sprite.
+ * @param type The sprite type.
+ */
+static void sprite_rect(t_game *game, t_sprite_view *v, double center, int type)
+{
+	t_texture	*texture;
+	int			level;
+
+	v->height = (int)(game->render_h / v->depth);
+	v->width = (int)(game->render_w / (2 * hypot(game->plane_x, game->plane_y)
+				* v->depth));
+	v->left = (int)floor(center - v->width / 2.0);
+	v->top = (game->render_h - v->height) / 2;
+	v->x0 = v->left;
+	if (v->x0 < 0)
+		v->x0 = 0;
+	v->x1 = v->left + v->width;
+	if (v->x1 > game->render_w)
+		v->x1 = game->render_w;
+	v->y0 = v->top;
+	if (v->y0 < 0)
+		v->y0 = 0;
+	v->y1 = v->top + v->height;
+	if (v->y1 > game->render_h)
+		v->y1 = game->render_h;
+	texture = &game->tex[SPRITE1 + type];
+	level = 0;
+	while (level + 1 < texture->mip_count
+		&& texture->mips[level + 1].height >= v->height
+		&& texture->mips[level + 1].width >= v->width)
+		level++;
+	v->mip = &texture->mips[level];
+	level = fog_level(&game->fog, v->depth);
+	v->fog_scale = game->fog.scale[level];
+	v->fog_add = game->fog.add[level];
+}
+
+/**
+ * @brief Projects every sprite and keeps the ones that can show up in the frame.
+ *
+ * The position of a sprite relative to the player is transformed into camera space with the
+ * inverse of the [plane dir] matrix: depth is the distance along dir, the same perpendicular
+ * distance the walls are measured with, and the other coordinate divided by the depth is the
+ * camera_x of the column it projects to. Sprites behind the camera (or closer than
+ * SPRITE_NEAR), outside the screen, too small to cover a pixel, or behind the walls of every
+ * column they cover are dropped here, before sorting.
+ *
+ * @param game Pointer to the t_game structure holding the camera and sprites.
+ */
+static void sprites_project(t_game *game)
+{
+	t_sprites		*s;
+	t_sprite_view	*v;
+	double			inv_det;
+	double			rel[2];
+	int				i;
+
+	s = &game->sprites;
+	s->visible = 0;
+	inv_det = 1.0 / (game->plane_x * game->dir_y - game->dir_x * game->plane_y);
+	i = -1;
+	while (++i < s->count)
+	{
+		rel[0] = s->list[i].x - game->player_x;
+		rel[1] = s->list[i].y - game->player_y;
+		v = &s->views[s->visible];
+		v->depth = inv_det * (game->plane_x * rel[1] - game->plane_y * rel[0]);
+		if (v->depth < SPRITE_NEAR)
+			continue ;
+		sprite_rect(game, v, game->render_w / 2.0 * (1.0 + inv_det * (game->dir_y
+						* rel[0] - game->dir_x * rel[1]) / v->depth), s->list[i].type);
+		if (v->x0 < v->x1 && v->y0 < v->y1 && sprite_unoccluded(game, v))
+			s->visible++;
+	}
+}
+
+/**
+ * @brief Makes room in game->sprites.cover for a coverage row mask per tile and row.
+ *
+ * It only grows, so a lower dynamic resolution scale reuses the same buffer.
+ *
+ * @param game Pointer to the t_game structure holding the sprites.
+ */
+static void sprites_cover(t_game *game)
+{
+	size_t	size;
+
+	size = (size_t)((game->render_w + RENDER_TILE - 1) / RENDER_TILE)
+		* game->render_h;
+	if (size <= game->sprites.cover_size)
+		return ;
+	free(game->sprites.cover);
+	game->sprites.cover = malloc(size * sizeof(uint16_t));
+	if (!game->sprites.cover)
+		return (perror("malloc"), exit(ERROR));
+	game->sprites.cover_size = size;
+}
+
+/**
+ * @brief Draws the sprites over the rendered walls, floor and ceiling.
+ *
+ * The sprites are projected and culled on the calling thread, sorted from the farthest to
+ * the nearest with sprite_sort(), and then drawn nearest first by the worker pool in tiles of
+ * RENDER_TILE columns (see sprite_tile()). Each pixel is tested against the wall distance of
+ * its column, kept by render_column() in game->zbuf, so walls in front of a sprite hide it,
+ * and against the pixels nearer sprites already drew, so each pixel is shaded at most once.
+ * It runs after render_floor() and before the upscale. Does nothing when the map has no
+ * sprites.
+ *
+ * @param game Pointer to the t_game structure.
+ */
+void render_sprites(t_game *game)
+{
+	if (!game->sprites.count)
+		return ;
+	sprites_project(game);
+	if (!game->sprites.visible)
+		return ;
+	sprite_sort(&game->sprites);
+	sprites_cover(game);
+	pool_run(&game->pool, sprite_tile, game,
+		(game->render_w + RENDER_TILE - 1) / RENDER_TILE);
+}
@@ -0,0 +1,168 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Collects the columns of a tile where a sprite is in front of the wall.
+ *
+ * For each such column the texture column it shows is resolved once, so the row loop only
+ * has to step down the texture.
+ *
+ * @param game Pointer to the t_game structure holding the depth buffer.
+ * @param v Pointer to the projected sprite.
+ * @param range Columns [x0, x1) of the tile covered by the sprite.
+ * @param src Array receiving the texture column of each visible column.
+ * @return int Number of visible columns; their indices are written to range[2...].
+ */
+static int sprite_columns(t_game *game, t_sprite_view *v, int *range,
+	unsigned int **src)
+{
+	int	n;
+	int	x;
+
+	n = 0;
+	x = range[0] - 1;
+	while (++x < range[1])
+	{
+		if (v->depth >= game->zbuf[x])
+			continue ;
+		src[n] = v->mip->columns + (size_t)((long)(x - v->left)
+				* v->mip->width / v->width) * v->mip->height;
+		range[2 + n++] = x;
+	}
+	return (n);
+}
+
+/**
+ * @brief Updates what is already covered in a tile before the next sprite is drawn.
+ *
+ * The row masks are cleared as sprites reach them, so a tile only clears the rows its sprites
+ * span. Sprites come nearest first, so once a column's wall is no nearer than the sprite it
+ * is nearer than all the sprites left, and the column is blocked for good. The covered band
+ * grows from the horizon over the rows where every column is blocked or already drawn.
+ * Every sprite stands on the floor and straddles the horizon, so whatever of it falls in
+ * the band is hidden.
+ *
+ * @param game Pointer to the t_game structure holding the depth buffer.
+ * @param c Pointer to the coverage of the tile.
+ * @param v Pointer to the next sprite.
+ */
+static void cover_update(t_game *game, t_sprite_cover *c, t_sprite_view *v)
+{
+	int	x;
+
+	if (v->y0 < c->lo)
+		ft_memset(c->rows + v->y0, 0, (c->lo - v->y0) * sizeof(uint16_t));
+	if (v->y0 < c->lo)
+		c->lo = v->y0;
+	if (v->y1 > c->hi)
+		ft_memset(c->rows + c->hi, 0, (v->y1 - c->hi) * sizeof(uint16_t));
+	if (v->y1 > c->hi)
+		c->hi = v->y1;
+	x = -1;
+	while (++x < RENDER_TILE)
+		if (c->x + x >= game->render_w || game->zbuf[c->x + x] <= v->depth)
+			c->blocked |= 1u << x;
+	while (c->top > c->lo
+		&& (c->rows[c->top - 1] | c->blocked) == SPRITE_COVER_FULL)
+		c->top--;
+	while (c->bottom < c->hi
+		&& (c->rows[c->bottom] | c->blocked) == SPRITE_COVER_FULL)
+		c->bottom++;
+}
+
+/**
+ * @brief Draws the part of one sprite that falls into a tile.
+ *
+ * The sprite is drawn row by row over its visible columns, so the frame is written a short
+ * run at a time instead of down a column, and the rows of the covered band are skipped. The
+ * texture row steps in 16.16 fixed point as for walls; texels whose alpha is TEXEL_MASKED are
+ * transparent, and so are pixels a nearer sprite already drew. The others are shaded with
+ * the fog of the sprite and marked as drawn.
+ *
+ * @param game Pointer to the t_game structure holding the render target.
+ * @param v Pointer to the projected sprite.
+ * @param range Columns [x0, x1) of the tile covered by the sprite.
+ * @param c Pointer to the coverage of the tile.
+ */
+static void sprite_draw(t_game *game, t_sprite_view *v, int *range,
+	t_sprite_cover *c)
+{
+	unsigned int	*src[RENDER_TILE];
+	unsigned int	*row;
+	unsigned int	texel;
+	unsigned int	pos[2];
+	int				i[3];
+
+	i[2] = sprite_columns(game, v, range, src);
+	pos[0] = (unsigned int)(((long)(v->y0 - v->top) * v->mip->height << 16)
+			/ v->height);
+	pos[1] = (unsigned int)(((long)v->mip->height << 16) / v->height);
+	i[0] = v->y0 - 1;
+	while (i[2] && ++i[0] < v->y1)
+	{
+		if (i[0] >= c->top && i[0] < c->bottom)
+		{
+			pos[0] += pos[1] * (c->bottom - i[0]);
+			i[0] = c->bottom - 1;
+			continue ;
+		}
+		row = game->target.pixels + (size_t)i[0] * game->target.pitch;
+		i[1] = -1;
+		while (++i[1] < i[2])
+		{
+			texel = src[i[1]][pos[0] >> 16];
+			if ((texel & TEXEL_MASKED) == TEXEL_MASKED
+				|| c->rows[i[0]] >> (range[2 + i[1]] - c->x) & 1)
+				continue ;
+			c->rows[i[0]] |= 1u << (range[2 + i[1]] - c->x);
+			row[range[2 + i[1]]]
+				= ((((texel & 0xFF00FF) * v->fog_scale) >> 8) & 0xFF00FF)
+				+ ((((texel & 0x00FF00) * v->fog_scale) >> 8) & 0x00FF00)
+				+ v->fog_add;
+		}
+		pos[0] += pos[1];
+	}
+}
+
+/**
+ * @brief Draws the sprites covering one tile of RENDER_TILE columns.
+ *
+ * This function is the task run by the worker pool. It walks the sorted sprites backwards,
+ * from the nearest to the farthest, and keeps the pixels of the tile each one drew in
+ * game->sprites.cover, so the nearest opaque texel of every pixel is the one that stays,
+ * and the sprites behind a crowd of nearer ones cost little more than a look at the covered
+ * band. Once every column is behind a wall the rest are skipped. Every tile only writes its
+ * own columns, so tiles can be drawn concurrently and the result does not depend on the
+ * number of threads.
+ *
+ * @param ctx Pointer to the t_game structure.
+ * @param tile Index of the tile to draw.
+ */
+void sprite_tile(void *ctx, int tile)
+{
+	t_game			*game;
+	t_sprite_view	*v;
+	t_sprite_cover	c;
+	int				range[2 + RENDER_TILE];
+	int				i;
+
+	game = (t_game *)ctx;
+	c = (t_sprite_cover){game->sprites.cover + (size_t)tile * game->render_h, 0,
+		tile * RENDER_TILE, game->render_h / 2, game->render_h / 2,
+		game->render_h / 2, game->render_h / 2};
+	i = game->sprites.visible;
+	while (--i >= 0 && c.blocked != SPRITE_COVER_FULL)
+	{
+		v = &game->sprites.views[game->sprites.order[i]];
+		range[0] = c.x;
+		if (v->x0 > range[0])
+			range[0] = v->x0;
+		range[1] = c.x + RENDER_TILE;
+		if (v->x1 < range[1])
+			range[1] = v->x1;
+		if (range[0] >= range[1])
+			continue ;
+		cover_update(game, &c, v);
+		if (v->y0 < c.top || v->y1 > c.bottom)
+			sprite_draw(game, v, range, &c);
+	}
+}
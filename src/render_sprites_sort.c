@@ -0,0 +1,98 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Runs one counting pass of the radix sort on RADIX_BITS bits of the keys.
+ *
+ * The pass is stable, so sorting on the low digits first and the high digits last gives the
+ * full order. A pass where every key has the same digit would only copy the arrays, so it is
+ * skipped, which is common for the high digits of sprite distances.
+ *
+ * @param keys Input and output keys.
+ * @param order Input and output view indices.
+ * @param n Number of keys.
+ * @param shift Position of the digit in the keys.
+ * @return int 1 if the output arrays were written, 0 if the pass was skipped.
+ */
+static int radix_pass(uint32_t **keys, int **order, int n, int shift)
+{
+	int			count[1 << RADIX_BITS];
+	uint32_t	digit;
+	int			sum;
+	int			i;
+
+	ft_memset(count, 0, sizeof(count));
+	i = -1;
+	while (++i < n)
+		count[(keys[0][i] >> shift) & ((1 << RADIX_BITS) - 1)]++;
+	if (count[(keys[0][0] >> shift) & ((1 << RADIX_BITS) - 1)] == n)
+		return (0);
+	sum = 0;
+	i = -1;
+	while (++i < 1 << RADIX_BITS)
+	{
+		sum += count[i];
+		count[i] = sum - count[i];
+	}
+	i = -1;
+	while (++i < n)
+	{
+		digit = (keys[0][i] >> shift) & ((1 << RADIX_BITS) - 1);
+		keys[1][count[digit]] = keys[0][i];
+		order[1][count[digit]] = order[0][i];
+		count[digit]++;
+	}
+	return (1);
+}
+
+/**
+ * @brief Sorts the visible sprites from the farthest to the nearest.
+ *
+ * The key of a sprite is the bit pattern of its depth as a float, inverted: for positive
+ * floats the bit patterns sort like the values, and inverting them turns the ascending
+ * least-significant-digit radix sort into a far-to-near order. It takes 32 / RADIX_BITS
+ * linear passes over the keys whatever their distribution, instead of the n log n
+ * comparisons of a comparison sort. The passes alternate between the two halves of
+ * sprites->keys and sprites->order, and the first half of sprites->order receives the
+ * indices of the views from the farthest to the nearest; sprite_tile() walks it backwards.
+ *
+ * @param s Pointer to the t_sprites structure holding the projected sprites.
+ */
+void sprite_sort(t_sprites *s)
+{
+	uint32_t	*keys[2];
+	int			*order[2];
+	uint32_t	*tmp_keys;
+	int			*tmp_order;
+	float		depth;
+	int			shift;
+	int			i;
+
+	i = -1;
+	while (++i < s->visible)
+	{
+		depth = (float)s->views[i].depth;
+		ft_memcpy(&s->keys[i], &depth, sizeof(uint32_t));
+		s->keys[i] = ~s->keys[i];
+		s->order[i] = i;
+	}
+	keys[0] = s->keys;
+	keys[1] = s->keys + s->cap;
+	order[0] = s->order;
+	order[1] = s->order + s->cap;
+	shift = 0;
+	while (s->visible > 1 && shift < 32)
+	{
+		if (radix_pass(keys, order, s->visible, shift))
+		{
+			tmp_keys = keys[0];
+			keys[0] = keys[1];
+			keys[1] = tmp_keys;
+			tmp_order = order[0];
+			order[0] = order[1];
+			order[1] = tmp_order;
+		}
+		shift += RADIX_BITS;
+	}
+	if (order[0] != s->order)
+		ft_memcpy(s->order, order[0], s->visible * sizeof(int));
+}
@@ -0,0 +1,37 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Builds the ray and row tables for the current render resolution.
+ *
+ * camera_x[x] is the position of column x on the camera plane, from -1 at the left edge to
+ * almost 1 at the right edge; the ray of the column is dir + plane * camera_x[x]. row_dist[y]
+ * is the distance at which row y sees the ceiling (above the horizon) or the floor (below it),
+ * render_h / |render_h - 2y|, with 1 on the horizon itself. Both are in camera-plane units, so
+ * they only depend on the render resolution and not on the field of view (the length of the
+ * camera plane, FOV_PLANE) or the camera; render_resize() rebuilds them whenever the
+ * resolution changes. The arrays are allocated at window size by init_window(), so this never
+ * allocates. The tables are only read while rendering and are shared by every worker.
+ *
+ * @param game Pointer to the t_game structure holding the tables.
+ */
+void tables_build(t_game *game)
+{
+	t_tables	*t;
+	int			i;
+
+	t = &game->tables;
+	t->width = game->render_w;
+	t->height = game->render_h;
+	i = -1;
+	while (++i < t->width)
+		t->camera_x[i] = 2 * i / (double)t->width - 1;
+	i = -1;
+	while (++i < t->height)
+	{
+		t->row_dist[i] = 1.0;
+		if (t->height - 2 * i > 0)
+			t->row_dist[i] = t->height / (double)(t->height - 2 * i);
+		else if (2 * i - t->height > 0)
+			t->row_dist[i] = t->height / (double)(2 * i - t->height);
+	}
+}
@@ -0,0 +1,140 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Main loop of a persistent render worker.
+ *
+ * The worker sleeps on the pool's start condition until a new frame generation is
+ * published (or the pool is shutting down). It then drains its own tile queue, steals
+ * from the other workers once it runs dry, and reports completion to the caller of
+ * pool_run().
+ *
+ * @param arg Pointer to the t_worker describing this thread.
+ * @return void* Always returns NULL.
+ */
+static void *worker_main(void *arg)
+{
+	t_worker		*worker;
+	t_pool			*pool;
+	unsigned long	seen;
+
+	worker = (t_worker *)arg;
+	pool = worker->pool;
+	seen = 0;
+	while (1)
+	{
+		pthread_mutex_lock(&pool->lock);
+		while (!pool->quit && pool->generation == seen)
+			pthread_cond_wait(&pool->start, &pool->lock);
+		if (pool->quit)
+			return (pthread_mutex_unlock(&pool->lock), NULL);
+		seen = pool->generation;
+		pthread_mutex_unlock(&pool->lock);
+		pool_work(pool, worker->id);
+		pthread_mutex_lock(&pool->lock);
+		pool->pending--;
+		if (pool->pending == 0)
+			pthread_cond_signal(&pool->done);
+		pthread_mutex_unlock(&pool->lock);
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Creates the worker pool used to render the scene in parallel.
+ *
+ * The calling thread always acts as worker 0, so only count - 1 threads are spawned.
+ * With a count of 1 no thread is created and pool_run() executes every tile inline.
+ * Each tile queue lives on its own cache line to avoid false sharing between workers.
+ *
+ * @param pool Pointer to the t_pool structure to initialize.
+ * @param count Total number of workers, including the calling thread.
+ */
+void pool_init(t_pool *pool, int count)
+{
+	int	i;
+
+	pool->count = count;
+	pool->threads = ft_calloc(count, sizeof(pthread_t));
+	pool->workers = ft_calloc(count, sizeof(t_worker));
+	pool->queues = aligned_alloc(64, count * sizeof(t_tile_queue));
+	if (!pool->threads || !pool->workers || !pool->queues)
+		return (perror("malloc"), exit(ERROR));
+	if (pthread_mutex_init(&pool->lock, NULL) != 0
+		|| pthread_cond_init(&pool->start, NULL) != 0
+		|| pthread_cond_init(&pool->done, NULL) != 0)
+		return (perror("pthread"), exit(ERROR));
+	i = 0;
+	while (i < count)
+	{
+		pool->workers[i].pool = pool;
+		pool->workers[i].id = i;
+		atomic_init(&pool->queues[i].range, 0);
+		if (i > 0 && pthread_create(&pool->threads[i], NULL, worker_main,
+				&pool->workers[i]) != 0)
+			return (perror("pthread_create"), exit(ERROR));
+		i++;
+	}
+}
+
+/**
+ * @brief Runs a task over a number of tiles on every worker and waits for it to finish.
+ *
+ * The tiles are split into one contiguous range per worker, the helper threads are woken up,
+ * and the calling thread renders its own share before blocking until every helper is done.
+ *
+ * @param pool Pointer to the initialized worker pool.
+ * @param task Function called once per tile.
+ * @param ctx Opaque pointer passed to every task call.
+ * @param tiles Number of tiles to process.
+ */
+void pool_run(t_pool *pool, t_task task, void *ctx, int tiles)
+{
+	pool->task = task;
+	pool->ctx = ctx;
+	pool_split_tiles(pool, tiles);
+	if (pool->count > 1)
+	{
+		pthread_mutex_lock(&pool->lock);
+		pool->pending = pool->count - 1;
+		pool->generation++;
+		pthread_cond_broadcast(&pool->start);
+		pthread_mutex_unlock(&pool->lock);
+	}
+	pool_work(pool, 0);
+	if (pool->count > 1)
+	{
+		pthread_mutex_lock(&pool->lock);
+		while (pool->pending > 0)
+			pthread_cond_wait(&pool->done, &pool->lock);
+		pthread_mutex_unlock(&pool->lock);
+	}
+}
+
+/**
+ * @brief Stops and joins every worker thread and releases the pool resources.
+ *
+ * It is safe to call on a pool that was never initialized.
+ *
+ * @param pool Pointer to the worker pool to destroy.
+ */
+void pool_destroy(t_pool *pool)
+{
+	int	i;
+
+	if (!pool->workers)
+		return ;
+	pthread_mutex_lock(&pool->lock);
+	pool->quit = 1;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->lock);
+	i = 1;
+	while (i < pool->count)
+		pthread_join(pool->threads[i++], NULL);
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->start);
+	pthread_cond_destroy(&pool->done);
+	free(pool->threads);
+	free(pool->workers);
+	free(pool->queues);
+	pool->workers = NULL;
+}
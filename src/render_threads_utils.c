@@ -0,0 +1,126 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Takes the next tile from the front of a worker's own queue.
+ *
+ * The queue is a single packed word (head in the low 32 bits, tail in the high 32 bits),
+ * so the owner and any thief race on the same compare-and-swap and a tile can never be
+ * handed out twice.
+ *
+ * @param queue Pointer to the tile queue.
+ * @return int The tile index, or -1 if the queue is empty.
+ */
+static int queue_pop(t_tile_queue *queue)
+{
+	unsigned long long	cur;
+
+	cur = atomic_load(&queue->range);
+	while ((unsigned int)cur < (unsigned int)(cur >> 32))
+	{
+		if (atomic_compare_exchange_weak(&queue->range, &cur, cur + 1))
+			return ((int)(unsigned int)cur);
+	}
+	return (-1);
+}
+
+/**
+ * @brief Steals a tile from the back of another worker's queue.
+ *
+ * @param queue Pointer to the victim's tile queue.
+ * @return int The stolen tile index, or -1 if the queue is empty.
+ */
+static int queue_steal(t_tile_queue *queue)
+{
+	unsigned long long	cur;
+
+	cur = atomic_load(&queue->range);
+	while ((unsigned int)cur < (unsigned int)(cur >> 32))
+	{
+		if (atomic_compare_exchange_weak(&queue->range, &cur,
+				cur - (1ULL << 32)))
+			return ((int)(unsigned int)(cur >> 32) - 1);
+	}
+	return (-1);
+}
+
+/**
+ * @brief Chooses how many render workers to use.
+ *
+ * The CUB3D_THREADS environment variable takes precedence over the THREADS build setting.
+ * A value of 0 (the default) uses one worker per online CPU. The result is clamped to
+ * [1, MAX_THREADS].
+ *
+ * @return int The number of workers, including the main thread.
+ */
+int render_thread_count(void)
+{
+	char	*env;
+	long	count;
+
+	count = THREADS;
+	env = getenv("CUB3D_THREADS");
+	if (env)
+		count = ft_atoi(env);
+	if (count <= 0)
+		count = sysconf(_SC_NPROCESSORS_ONLN);
+	if (count < 1)
+		count = 1;
+	if (count > MAX_THREADS)
+		count = MAX_THREADS;
+	return ((int)count);
+}
+
+/**
+ * @brief Splits the tiles of a job into one contiguous range per worker.
+ *
+ * Neighbouring tiles stay on the same worker so that its columns share cache lines
+ * and texture data; imbalance is corrected later by stealing.
+ *
+ * @param pool Pointer to the worker pool.
+ * @param tiles Total number of tiles in the job.
+ */
+void pool_split_tiles(t_pool *pool, int tiles)
+{
+	unsigned long long	head;
+	unsigned long long	tail;
+	int					i;
+
+	i = 0;
+	while (i < pool->count)
+	{
+		head = (unsigned long long)tiles * i / pool->count;
+		tail = (unsigned long long)tiles * (i + 1) / pool->count;
+		atomic_store(&pool->queues[i].range, (tail << 32) | head);
+		i++;
+	}
+}
+
+/**
+ * @brief Processes tiles until every queue in the pool is empty.
+ *
+ * The worker drains its own queue first and then scans the other workers in order,
+ * stealing one tile at a time from the back of their ranges. Queues only ever shrink
+ * during a job, so one empty pass over all of them means the job is finished.
+ *
+ * @param pool Pointer to the worker pool.
+ * @param id Index of the calling worker.
+ */
+void pool_work(t_pool *pool, int id)
+{
+	int	tile;
+	int	i;
+
+	while (1)
+	{
+		tile = queue_pop(&pool->queues[id]);
+		i = 1;
+		while (tile < 0 && i < pool->count)
+		{
+			tile = queue_steal(&pool->queues[(id + i) % pool->count]);
+			i++;
+		}
+		if (tile < 0)
+			return ;
+		pool->task(pool->ctx, tile);
+	}
+}
@@ -0,0 +1,134 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Copies a single pixel row of a block from the column buffer to the image.
+ *
+ * Used for the borders of the frame that do not fill a whole 4x4 block.
+ *
+ * @param src Pointer to the column buffer at (x_start, y).
+ * @param dst Pointer to the target row at (x_start, y).
+ * @param count Number of pixels (columns) to copy.
+ * @param stride Number of pixels per column of the column buffer.
+ */
+static void transpose_row_scalar(const unsigned int *src, unsigned int *dst,
+	int count, size_t stride)
+{
+	int	i;
+
+	i = 0;
+	while (i < count)
+	{
+		dst[i] = src[i * stride];
+		i++;
+	}
+}
+
+/**
+ * @brief Transposes a 4x4 pixel block from the column buffer to the render target.
+ *
+ * Four rows of four consecutive columns are loaded as four 16-byte vectors, shuffled into
+ * rows with unpack instructions and stored as four 16-byte target rows. Without SSE2 the
+ * same block is copied pixel by pixel.
+ *
+ * @param src Pointer to the column buffer at the block's top-left pixel.
+ * @param dst Pointer to the target at the block's top-left pixel.
+ * @param pitch Number of pixels per target row.
+ * @param stride Number of pixels per column of the column buffer.
+ */
+static void transpose_block(const unsigned int *src, unsigned int *dst,
+	size_t pitch, size_t stride)
+{
+#ifdef __SSE2__
+	__m128i	c[4];
+	__m128i	t[4];
+
+	c[0] = _mm_loadu_si128((const __m128i *)(src));
+	c[1] = _mm_loadu_si128((const __m128i *)(src + stride));
+	c[2] = _mm_loadu_si128((const __m128i *)(src + 2 * stride));
+	c[3] = _mm_loadu_si128((const __m128i *)(src + 3 * stride));
+	t[0] = _mm_unpacklo_epi32(c[0], c[1]);
+	t[1] = _mm_unpacklo_epi32(c[2], c[3]);
+	t[2] = _mm_unpackhi_epi32(c[0], c[1]);
+	t[3] = _mm_unpackhi_epi32(c[2], c[3]);
+	_mm_storeu_si128((__m128i *)(dst), _mm_unpacklo_epi64(t[0], t[1]));
+	_mm_storeu_si128((__m128i *)(dst + pitch), _mm_unpackhi_epi64(t[0], t[1]));
+	_mm_storeu_si128((__m128i *)(dst + 2 * pitch), _mm_unpacklo_epi64(t[2], t[3]));
+	_mm_storeu_si128((__m128i *)(dst + 3 * pitch), _mm_unpackhi_epi64(t[2], t[3]));
+#else
+	int	i;
+
+	i = 0;
+	while (i < 4)
+	{
+		transpose_row_scalar(src + i, dst + i * pitch, 4, stride);
+		i++;
+	}
+#endif
+}
+
+/**
+ * @brief Transposes one band of four rows of a column range into the render target.
+ *
+ * @param game Pointer to the t_game structure holding the column buffer and the target.
+ * @param y First row of the band.
+ * @param x_start First column to copy.
+ * @param x_end One past the last column to copy.
+ */
+static void transpose_band(t_game *game, int y, int x_start, int x_end)
+{
+	unsigned int	*dst;
+	size_t			pitch;
+	size_t			stride;
+	int				x;
+	int				i;
+
+	pitch = game->target.pitch;
+	stride = game->render_h;
+	dst = game->target.pixels + y * pitch;
+	x = x_start;
+	while (x + 4 <= x_end)
+	{
+		transpose_block(game->colbuf + x * stride + y, dst + x, pitch, stride);
+		x += 4;
+	}
+	i = 0;
+	while (x < x_end && i < 4)
+	{
+		transpose_row_scalar(game->colbuf + x * stride + y + i,
+			dst + x + i * pitch, x_end - x, stride);
+		i++;
+	}
+}
+
+/**
+ * @brief Copies a range of columns from the column-major buffer into the render target.
+ *
+ * The columns are walked in bands of four rows so that every cache line read from the
+ * column buffer is reused for four consecutive bands while the target is written one full
+ * row segment at a time. Rows left over when render_h is not a multiple of four are copied
+ * one by one. The target is the MLX image itself at full render scale, or the low-resolution
+ * frame that render_upscale() stretches afterwards.
+ *
+ * @param game Pointer to the t_game structure holding the column buffer and the target.
+ * @param x_start First column to copy.
+ * @param x_end One past the last column to copy.
+ */
+void transpose_columns(t_game *game, int x_start, int x_end)
+{
+	unsigned int	*dst;
+	int				y;
+
+	y = 0;
+	while (y + 4 <= game->render_h)
+	{
+		transpose_band(game, y, x_start, x_end);
+		y += 4;
+	}
+	while (y < game->render_h)
+	{
+		dst = game->target.pixels + (size_t)y * game->target.pitch;
+		transpose_row_scalar(game->colbuf + (size_t)x_start * game->render_h + y,
+			dst + x_start, x_end - x_start, game->render_h);
+		y++;
+	}
+}
@@ -0,0 +1,141 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Copies the player's position, direction and camera plane into a camera.
+ *
+ * @param game Pointer to the t_game structure holding the player.
+ * @param cam Pointer to the camera to fill.
+ */
+void camera_get(t_game *game, t_camera *cam)
+{
+	*cam = (t_camera){game->player_x, game->player_y, game->dir_x, game->dir_y,
+		game->plane_x, game->plane_y};
+}
+
+/**
+ * @brief Places the player at a camera's position, direction and camera plane.
+ *
+ * @param game Pointer to the t_game structure holding the player.
+ * @param cam Pointer to the camera to copy.
+ */
+void camera_set(t_game *game, t_camera *cam)
+{
+	game->player_x = cam->x;
+	game->player_y = cam->y;
+	game->dir_x = cam->dir_x;
+	game->dir_y = cam->dir_y;
+	game->plane_x = cam->plane_x;
+	game->plane_y = cam->plane_y;
+}
+
+/**
+ * @brief Runs the simulation ticks that are due and returns how far into the next one we are.
+ *
+ * Game time advances in fixed ticks of 1 / SIM_HZ seconds, whatever the frame rate: the time
+ * since the last call goes into an accumulator and every whole tick in it runs
+ * update_movement() and the door cooldown once. After a stall (a long frame, the title
+ * screen) at most SIM_MAX_TICKS are run and the rest is dropped, so the game slows down
+ * instead of trying to catch up forever. The state before the last tick is kept in
+ * game->sim.prev for sim_interpolate(), and the player fields hold the state after it.
+ *
+ * @param game Pointer to the t_game structure holding the simulation clock.
+ * @return double Fraction of a tick left in the accumulator, in [0, 1).
+ */
+double sim_advance(t_game *game)
+{
+	t_sim				*sim;
+	unsigned long long	now;
+	unsigned long long	tick;
+	int					n;
+
+	sim = &game->sim;
+	now = stage_clock();
+	tick = 1000000000ULL / SIM_HZ;
+	if (!sim->last)
+		camera_get(game, &sim->prev);
+	else
+		sim->acc += now - sim->last;
+	sim->last = now;
+	if (sim->acc > tick * SIM_MAX_TICKS)
+		sim->acc = tick * SIM_MAX_TICKS;
+	n = 0;
+	while (sim->acc >= tick)
+	{
+		if (n++ == 0)
+			camera_get(game, &sim->prev);
+		else
+			sim->prev = sim->curr;
+		update_movement(game);
+		camera_get(game, &sim->curr);
+		if (game->door_cooldown > 0)
+			game->door_cooldown--;
+		sim->acc -= tick;
+	}
+	return ((double)sim->acc / tick);
+}
+
+/**
+ * @brief Places the camera between the last two simulation states for drawing.
+ *
+ * The simulated state is saved in game->sim.curr and the player fields are set to
+ * prev + (curr - prev) * alpha, so motion looks smooth at any frame rate even though the
+ * simulation only moves at SIM_HZ. The caller restores the simulated state with
+ * camera_set(game, &game->sim.curr) once the frame is drawn. Direction and plane are blended
+ * linearly; one tick turns them by so little that their length barely changes.
+ *
+ * @param game Pointer to the t_game structure holding the simulation states.
+ * @param alpha Fraction of a tick since the last state, from sim_advance().
+ */
+void sim_interpolate(t_game *game, double alpha)
+{
+	t_camera	*p;
+	t_camera	*c;
+
+	camera_get(game, &game->sim.curr);
+	p = &game->sim.prev;
+	c = &game->sim.curr;
+	game->player_x = p->x + (c->x - p->x) * alpha;
+	game->player_y = p->y + (c->y - p->y) * alpha;
+	game->dir_x = p->dir_x + (c->dir_x - p->dir_x) * alpha;
+	game->dir_y = p->dir_y + (c->dir_y - p->dir_y) * alpha;
+	game->plane_x = p->plane_x + (c->plane_x - p->plane_x) * alpha;
+	game->plane_y = p->plane_y + (c->plane_y - p->plane_y) * alpha;
+}
+
+/**
+ * @brief Turns the player right away, outside the simulation ticks (mouse look).
+ *
+ * Mouse movement is already measured in pixels, not per frame, so it is applied as it comes.
+ * The previous state is turned as well, so the next interpolated frames show the whole turn
+ * at once instead of blending it in over a tick.
+ *
+ * @param game Pointer to the t_game structure holding the player.
+ * @param angle The angle (in radians) to turn by.
+ */
+void sim_turn(t_game *game, double angle)
+{
+	t_camera	cur;
+
+	rotate_player(game, angle);
+	camera_get(game, &cur);
+	camera_set(game, &game->sim.prev);
+	rotate_player(game, angle);
+	camera_get(game, &game->sim.prev);
+	camera_set(game, &cur);
+}
+
+/**
+ * @brief Stops the simulation clock while the game loop sleeps with nothing to simulate.
+ *
+ * Without it the whole sleep would be simulated on waking: up to SIM_MAX_TICKS ticks at once
+ * with the key that woke the loop already held, a visible jump. The next sim_advance()
+ * restarts the clock instead, with exactly one tick due, so a key press moves the player in
+ * the very frame it wakes.
+ *
+ * @param game Pointer to the t_game structure holding the simulation clock.
+ */
+void sim_pause(t_game *game)
+{
+	game->sim.last = 0;
+	game->sim.acc = 1000000000ULL / SIM_HZ;
+}
@@ -0,0 +1,74 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Grows the sprite list and the per-frame work arrays to hold cap sprites.
+ *
+ * The list keeps its contents; the work arrays are rebuilt every frame by render_sprites(),
+ * so they are simply reallocated. keys and order hold two arrays each, the input and the
+ * output of every radix pass.
+ *
+ * @param s Pointer to the t_sprites structure.
+ * @param cap The new capacity.
+ */
+static void sprites_grow(t_sprites *s, int cap)
+{
+	t_sprite	*list;
+
+	list = realloc(s->list, (size_t)cap * sizeof(t_sprite));
+	if (!list)
+		return (perror("malloc"), exit(ERROR));
+	s->list = list;
+	free(s->views);
+	free(s->keys);
+	free(s->order);
+	s->views = malloc((size_t)cap * sizeof(t_sprite_view));
+	s->keys = malloc((size_t)cap * 2 * sizeof(uint32_t));
+	s->order = malloc((size_t)cap * 2 * sizeof(int));
+	if (!s->views || !s->keys || !s->order)
+		return (perror("malloc"), exit(ERROR));
+	s->cap = cap;
+}
+
+/**
+ * @brief Places a sprite in the world.
+ *
+ * The map parser adds one sprite per '2' to '5' cell, in the middle of the cell, but sprites
+ * can be added anywhere and at any time: the list grows by doubling, and the scene is marked
+ * as damaged so the next frame shows the new sprite (see damage_collect()). The texture of
+ * the type must be loaded before the first frame is rendered.
+ *
+ * @param game Pointer to the t_game structure holding the sprites.
+ * @param x World x coordinate of the sprite.
+ * @param y World y coordinate of the sprite.
+ * @param type Sprite type, 0 to SPRITE_TYPES - 1; it is drawn with texture SPRITE1 + type.
+ */
+void sprite_add(t_game *game, double x, double y, int type)
+{
+	t_sprites	*s;
+
+	s = &game->sprites;
+	if (s->count == s->cap)
+	{
+		if (s->cap)
+			sprites_grow(s, s->cap * 2);
+		else
+			sprites_grow(s, 16);
+	}
+	s->list[s->count++] = (t_sprite){x, y, type};
+	game->damage.map_gen++;
+}
+
+/**
+ * @brief Frees the sprite list, the per-frame work arrays and the coverage masks.
+ *
+ * @param game Pointer to the t_game structure holding the sprites.
+ */
+void sprites_free(t_game *game)
+{
+	free(game->sprites.list);
+	free(game->sprites.views);
+	free(game->sprites.keys);
+	free(game->sprites.order);
+	free(game->sprites.cover);
+	ft_memset(&game->sprites, 0, sizeof(t_sprites));
+}
@@ -0,0 +1,98 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Maps the memory backing the texture arena.
+ *
+ * The arena is an anonymous mapping, so it is page aligned (and therefore 64-byte aligned).
+ * When built with TEXTURE_HUGE_PAGES=1 it first asks for explicit 2 MiB huge pages and, if
+ * none are reserved on the system, falls back to normal pages with a transparent huge page
+ * hint.
+ *
+ * @param size Pointer to the requested size in bytes; rounded up to the mapped size.
+ * @return void* The mapped memory, or MAP_FAILED.
+ */
+static void *arena_map(size_t *size)
+{
+	void	*mem;
+	size_t	huge;
+
+	if (TEXTURE_HUGE_PAGES)
+	{
+		huge = (*size + HUGE_PAGE_SIZE - 1) & ~(size_t)(HUGE_PAGE_SIZE - 1);
+		mem = mmap(NULL, huge, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (mem != MAP_FAILED)
+			return (*size = huge, mem);
+	}
+	mem = mmap(NULL, *size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (TEXTURE_HUGE_PAGES && mem != MAP_FAILED)
+		madvise(mem, *size, MADV_HUGEPAGE);
+	return (mem);
+}
+
+/**
+ * @brief Packs every loaded texture into one contiguous arena and drops the loaded images.
+ *
+ * The mip chains of all textures are laid out back to back (see texture_layout()), level 0
+ * is copied column by column from the loaded image and the remaining levels are box-filtered
+ * from it. Afterwards the images are destroyed: the renderer only reads game->tex[id], whose
+ * levels all share the same column-major, cache-line aligned layout. Empty slots (the doors
+ * outside the bonus build, an untextured floor or ceiling) keep a mip_count of 0.
+ *
+ * @param game Pointer to the t_game structure holding the loaded images.
+ * @param count Number of textures to pack.
+ */
+void texture_arena_build(t_game *game, int count)
+{
+	unsigned int	*cursor;
+	size_t			size;
+	int				i;
+	int				level;
+
+	size = 0;
+	i = -1;
+	while (++i < count)
+	{
+		if (game->textures[i].img)
+			size += texture_layout(&game->tex[i], game->textures[i].width,
+					game->textures[i].height);
+	}
+	game->tex_arena_size = size * sizeof(unsigned int);
+	game->tex_arena = arena_map(&game->tex_arena_size);
+	if (game->tex_arena == MAP_FAILED)
+		return (game->tex_arena = NULL, perror("mmap"), exit(ERROR));
+	cursor = game->tex_arena;
+	i = -1;
+	while (++i < count)
+	{
+		if (!game->textures[i].img)
+			continue ;
+		level = -1;
+		while (++level < game->tex[i].mip_count)
+		{
+			game->tex[i].mips[level].columns = cursor;
+			cursor += ((size_t)game->tex[i].mips[level].width
+					* game->tex[i].mips[level].height + 15) & ~(size_t)15;
+		}
+		texture_to_columns(&game->textures[i], &game->tex[i].mips[0]);
+		texture_build_mips(&game->tex[i], i >= SPRITE1);
+		free(game->textures[i].img);
+		game->textures[i].img = NULL;
+		game->textures[i].addr = NULL;
+	}
+}
+
+/**
+ * @brief Unmaps the texture arena.
+ *
+ * It is safe to call when the arena was never built.
+ *
+ * @param game Pointer to the t_game structure holding the arena.
+ */
+void texture_arena_free(t_game *game)
+{
+	if (game->tex_arena)
+		munmap(game->tex_arena, game->tex_arena_size);
+	game->tex_arena = NULL;
+}
@@ -0,0 +1,186 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Reads a whole file into a NUL-terminated buffer.
+ *
+ * @param path Path of the file.
+ * @return char* The file content, or NULL if it cannot be opened or read.
+ */
+static char *read_file(char *path)
+{
+	char	*buf;
+	off_t	size;
+	ssize_t	bytes;
+	int		fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (NULL);
+	size = lseek(fd, 0, SEEK_END);
+	buf = NULL;
+	if (size >= 0 && lseek(fd, 0, SEEK_SET) == 0)
+		buf = malloc(size + 1);
+	bytes = -1;
+	if (buf)
+		bytes = read(fd, buf, size);
+	close(fd);
+	if (bytes != size)
+		return (free(buf), NULL);
+	buf[size] = '\0';
+	return (buf);
+}
+
+/**
+ * @brief Returns the index of a pixel key in the color table.
+ *
+ * Keys of up to two characters (almost every XPM) index a direct table built by
+ * xpm_colors(); longer keys are searched for among the nc color lines.
+ *
+ * @param x Pointer to the parser state.
+ * @param key The pixel key, cpp characters long.
+ * @return int The color index, or -1 if the key is not defined.
+ */
+static int color_index(t_xpm *x, char *key)
+{
+	int	i;
+
+	if (x->cpp <= 2)
+	{
+		i = (unsigned char)key[0];
+		if (x->cpp == 2)
+			i = i << 8 | (unsigned char)key[1];
+		return (x->direct[i]);
+	}
+	i = -1;
+	while (++i < x->nc)
+		if (!ft_strncmp(x->keys[i], key, x->cpp))
+			return (i);
+	return (-1);
+}
+
+/**
+ * @brief Parses the color lines that follow the XPM header.
+ *
+ * @param x Pointer to the parser state; buf, pos, nc and cpp must be set.
+ * @return int Returns OK on success, or ERROR if a color line is missing or malformed.
+ */
+static int xpm_colors(t_xpm *x)
+{
+	char	*line;
+	size_t	size;
+	int		i;
+
+	size = 1;
+	if (x->cpp <= 2)
+		size = (size_t)1 << (8 * x->cpp);
+	x->colors = malloc(x->nc * sizeof(unsigned int));
+	x->keys = malloc(x->nc * sizeof(char *));
+	x->direct = malloc(size * sizeof(int));
+	if (!x->colors || !x->keys || !x->direct)
+		return (perror("malloc"), exit(ERROR), ERROR);
+	ft_memset(x->direct, -1, size * sizeof(int));
+	i = -1;
+	while (++i < x->nc)
+	{
+		line = xpm_next_string(x->buf, &x->pos);
+		if (!line || (int)ft_strlen(line) < x->cpp
+			|| xpm_parse_color(line + x->cpp, &x->colors[i]) == ERROR)
+			return (ERROR);
+		x->keys[i] = line;
+		if (x->cpp == 1)
+			x->direct[(unsigned char)line[0]] = i;
+		else if (x->cpp == 2)
+			x->direct[(unsigned char)line[0] << 8 | (unsigned char)line[1]] = i;
+	}
+	return (OK);
+}
+
+/**
+ * @brief Parses the pixel rows of an XPM image into a row-major 32-bit image.
+ *
+ * Keys without a color line are black, as in MiniLibX.
+ *
+ * @param x Pointer to the parser state, positioned after the color lines.
+ * @param image Pointer to the image to fill; width and height must be set.
+ * @return int Returns OK on success, or ERROR if a row is missing or too short.
+ */
+static int xpm_pixels(t_xpm *x, t_img *image)
+{
+	unsigned int	*row;
+	char			*line;
+	int				col;
+	int				i;
+	int				j;
+
+	image->img = malloc((size_t)image->width * image->height * sizeof(unsigned int));
+	if (!image->img)
+		return (perror("malloc"), exit(ERROR), ERROR);
+	image->addr = image->img;
+	i = -1;
+	while (++i < image->height)
+	{
+		line = xpm_next_string(x->buf, &x->pos);
+		if (!line || ft_strlen(line) < (size_t)image->width * x->cpp)
+			return (ERROR);
+		row = (unsigned int *)(image->addr + (size_t)i * image->line_length);
+		j = -1;
+		while (++j < image->width)
+		{
+			col = color_index(x, line + (size_t)j * x->cpp);
+			row[j] = 0;
+			if (col >= 0)
+				row[j] = x->colors[col];
+		}
+	}
+	return (OK);
+}
+
+/**
+ * @brief Loads an XPM file into a 32-bit image in memory, without MiniLibX.
+ *
+ * Textures are loaded before any presentation backend exists, and a headless run has no X
+ * display to hand to mlx_xpm_file_to_image(), so the format is read here. The result is the
+ * same image MiniLibX would build: 0x00RRGGBB texels, transparent ("None") ones as
+ * TEXEL_MASKED, X11 color names resolved through MiniLibX's own table, any number of
+ * characters per pixel, and fields separated by spaces or tabs. image->img owns the pixels
+ * and is released with free().
+ *
+ * @param path Path of the XPM file.
+ * @param image Pointer to the image to fill.
+ * @return int Returns OK on success, or ERROR if the file cannot be read or is not a valid XPM.
+ */
+int xpm_load(char *path, t_img *image)
+{
+	t_xpm	x;
+	char	*line;
+	int		status;
+
+	ft_memset(&x, 0, sizeof(t_xpm));
+	ft_memset(image, 0, sizeof(t_img));
+	x.buf = read_file(path);
+	if (!x.buf)
+		return (ERROR);
+	xpm_strip_comments(x.buf);
+	line = xpm_next_string(x.buf, &x.pos);
+	status = ERROR;
+	if (line && sscanf(line, "%d %d %d %d", &image->width, &image->height,
+			&x.nc, &x.cpp) == 4 && image->width > 0 && image->height > 0
+		&& x.nc > 0 && x.cpp > 0 && image->width <= MAX_RESOLUTION
+		&& image->height <= MAX_RESOLUTION && xpm_colors(&x) == OK)
+	{
+		image->bpp = 32;
+		image->line_length = image->width * sizeof(unsigned int);
+		status = xpm_pixels(&x, image);
+	}
+	if (status == ERROR)
+	{
+		free(image->img);
+		image->img = NULL;
+		image->addr = NULL;
+	}
+	free(x.colors);
+	free(x.keys);
+	free(x.direct);
+	free(x.buf);
+	return (status);
+}
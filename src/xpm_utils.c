@@ -0,0 +1,129 @@
+#include "../include/cub3d.h"
+
+/**
+ * @brief Blanks out the C comments of an XPM file in place.
+ *
+ * Block and line comments outside string literals are overwritten with spaces, as MiniLibX
+ * does before parsing, so the quoted strings are all that is left to read.
+ *
+ * @param buf The file content, NUL-terminated.
+ */
+void xpm_strip_comments(char *buf)
+{
+	int	quoted;
+
+	quoted = 0;
+	while (*buf)
+	{
+		if (*buf == '"')
+			quoted = !quoted;
+		else if (!quoted && buf[0] == '/' && buf[1] == '*')
+		{
+			while (*buf && !(buf[0] == '*' && buf[1] == '/'))
+				*buf++ = ' ';
+			if (*buf)
+				ft_memset(buf++, ' ', 2);
+		}
+		else if (!quoted && buf[0] == '/' && buf[1] == '/')
+		{
+			while (*buf && *buf != '\n')
+				*buf++ = ' ';
+		}
+		if (*buf)
+			buf++;
+	}
+}
+
+/**
+ * @brief Returns the next quoted string of an XPM file.
+ *
+ * The closing quote is replaced by a NUL, so the result can be read as a C string.
+ *
+ * @param buf The file content, with comments stripped.
+ * @param pos Pointer to the read position, advanced past the string.
+ * @return char* The content of the string, or NULL if there is none left.
+ */
+char *xpm_next_string(char *buf, size_t *pos)
+{
+	char	*start;
+	char	*end;
+
+	start = ft_strchr(buf + *pos, '"');
+	if (!start)
+		return (NULL);
+	end = ft_strchr(start + 1, '"');
+	if (!end)
+		return (NULL);
+	*end = '\0';
+	*pos = end + 1 - buf;
+	return (start + 1);
+}
+
+/**
+ * @brief Looks up an X11 color name in the table MiniLibX ships (mlx_rgb.c).
+ *
+ * Names are compared without regard to case, and two-word names ("ghost white") are tried
+ * with the word that follows, exactly as mlx_xpm_file_to_image() does. "None" is in the table
+ * as -1, the transparent color.
+ *
+ * @param name The color name.
+ * @param next The word following it in the color line, or NULL.
+ * @return int The 0xRRGGBB color, -1 for "None", or 0 for an unknown name.
+ */
+static int color_by_name(char *name, char *next)
+{
+	char	buff[64];
+	int		i;
+
+	if (next && ft_strlen(name) + ft_strlen(next) + 2 <= sizeof(buff))
+	{
+		ft_strcpy(buff, name);
+		ft_strcat(buff, " ");
+		ft_strcat(buff, next);
+		name = buff;
+	}
+	i = 0;
+	while (mlx_col_name[i].name)
+	{
+		if (!strcasecmp(mlx_col_name[i].name, name))
+			return (mlx_col_name[i].color);
+		i++;
+	}
+	return (0);
+}
+
+/**
+ * @brief Resolves the color of an XPM color line, after its key.
+ *
+ * The line is a list of "<context> <color>" pairs; only the "c" (color visual) one is used.
+ * Colors are either "#RRGGBB" or an X11 name. Transparent pixels ("None") are returned as
+ * TEXEL_MASKED, the value MiniLibX stores for them.
+ *
+ * @param line The color line, after the pixel key.
+ * @param color Pointer receiving the 32-bit texel value.
+ * @return int Returns OK on success, or ERROR if the line has no "c" color.
+ */
+int xpm_parse_color(char *line, unsigned int *color)
+{
+	char	**words;
+	int		value;
+	int		i;
+
+	words = ft_split_charset(line, " \t");
+	if (!words)
+		return (perror("malloc"), exit(ERROR), ERROR);
+	i = 0;
+	while (words[i] && ft_strcmp(words[i], "c"))
+		i++;
+	if (!words[i] || !words[i + 1])
+		return (free_char_matrix(words), ERROR);
+	if (words[i + 1][0] == '#')
+		value = (int)strtol(words[i + 1] + 1, NULL, 16);
+	else
+		value = color_by_name(words[i + 1], words[i + 2]);
+	*color = (unsigned int)value;
+	if (value == -1)
+		*color = TEXEL_MASKED;
+	free_char_matrix(words);
+	return (OK);
+}